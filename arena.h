@@ -0,0 +1,60 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator: alloc() carves memory out of large blocks and reset()
+// releases everything at once while keeping the blocks for reuse.
+// Nothing is destroyed on reset — callers placing objects with
+// non-trivial destructors must destroy them first.
+class Arena {
+public:
+    explicit Arena(size_t block = 1 << 16) : blockSize(block), cur(0), used(0) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* alloc(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        for (;;) {
+            if (cur < blocks.size()) {
+                size_t p = (used + align - 1) & ~(align - 1);
+                if (p + bytes <= blocks[cur].size) {
+                    used = p + bytes;
+                    return blocks[cur].mem.get() + p;
+                }
+                cur++;
+                used = 0;
+                continue;
+            }
+            size_t sz = bytes + align > blockSize ? bytes + align : blockSize;
+            blocks.push_back(Block{std::unique_ptr<char[]>(new char[sz]), sz});
+        }
+    }
+
+    template <class T>
+    T* allocArray(size_t n) {
+        return static_cast<T*>(alloc(n * sizeof(T), alignof(T)));
+    }
+
+    void reset() { cur = 0; used = 0; }
+
+    size_t capacity() const {
+        size_t t = 0;
+        for (const Block &b : blocks) t += b.size;
+        return t;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> mem;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t blockSize;
+    size_t cur;     // block currently being carved
+    size_t used;    // bytes used in blocks[cur]
+};
+
+#endif // ARENA_H
@@ -0,0 +1,98 @@
+#include "batchenv.h"
+#include "solver.h"
+
+// index 6 is the "illegal action" slot: from == to never passes the check
+static const uint8_t ACT_FROM[7] = {0, 0, 1, 1, 2, 2, 0};
+static const uint8_t ACT_TO[7]   = {1, 2, 0, 2, 0, 1, 0};
+
+int BatchEnv::actionFrom(int a) { return ACT_FROM[a]; }
+int BatchEnv::actionTo(int a)   { return ACT_TO[a]; }
+int BatchEnv::actionOf(int from, int to) {
+    for (int a = 0; a < NUM_ACTIONS; a++)
+        if (ACT_FROM[a] == from && ACT_TO[a] == to) return a;
+    return -1;
+}
+
+uint64_t BatchEnv::distanceToGoal(uint64_t a, uint64_t b, uint64_t c, int n) {
+    (void)c;
+    return distanceToPeg(a, b, n, 2);
+}
+
+BatchEnv::BatchEnv(int batch, int numDisks, int threads)
+    : illegalPenalty(-1.0f), solveBonus(0.0f),
+      batchSize(batch), n(numDisks),
+      full(fullTowerMask(numDisks)),
+      startDistance(optimalMoveCount(numDisks)),
+      pool(threads)
+{
+    for (int p = 0; p < 3; p++) peg[p].resize(batch);
+    distance.resize(batch);
+    moves.resize(batch);
+    reward.resize(batch);
+    legal.resize(batch);
+    done.resize(batch);
+    episodeMoves.resize(batch);
+    reset();
+}
+
+void BatchEnv::reset() {
+    for (int i = 0; i < batchSize; i++) {
+        peg[0][i] = full;
+        peg[1][i] = 0;
+        peg[2][i] = 0;
+        distance[i] = startDistance;
+        moves[i] = 0;
+        reward[i] = 0;
+        legal[i] = 1;
+        done[i] = 0;
+    }
+}
+
+void BatchEnv::step(const uint8_t *actions) {
+    pool.parallelFor((size_t)batchSize, [&](size_t b, size_t e) {
+        stepRange(actions, b, e);
+    });
+}
+
+void BatchEnv::stepRange(const uint8_t *actions, size_t b, size_t e) {
+    uint64_t *A = peg[0].data(), *B = peg[1].data(), *C = peg[2].data();
+
+    // pass 1: legality and the move itself, branch-free so it vectorizes
+    for (size_t i = b; i < e; i++) {
+        unsigned act = actions[i] < NUM_ACTIONS ? actions[i] : NUM_ACTIONS;
+        unsigned f = ACT_FROM[act], t = ACT_TO[act];
+        uint64_t s = f == 0 ? A[i] : f == 1 ? B[i] : C[i];
+        uint64_t d = t == 0 ? A[i] : t == 1 ? B[i] : C[i];
+        uint64_t ls = s & (0 - s);               // top disk of source (0 if empty)
+        uint64_t ld = d & (0 - d);               // top disk of destination
+        // ld-1 wraps an empty destination to "infinitely large"
+        uint64_t ok = (uint64_t)((s != 0) & (f != t) & ((ls - 1) < (ld - 1)));
+        uint64_t mv = ls & (0 - ok);
+        A[i] ^= mv & (0 - (uint64_t)((f == 0) | (t == 0)));
+        B[i] ^= mv & (0 - (uint64_t)((f == 1) | (t == 1)));
+        C[i] ^= mv & (0 - (uint64_t)((f == 2) | (t == 2)));
+        legal[i] = (uint8_t)ok;
+        moves[i] += (uint32_t)ok;
+    }
+
+    // pass 2: rewards, termination and auto-reset
+    for (size_t i = b; i < e; i++) {
+        if (!legal[i]) {
+            reward[i] = illegalPenalty;
+            done[i] = 0;
+            continue;
+        }
+        uint64_t before = distance[i];
+        uint64_t after = C[i] == full ? 0 : distanceToGoal(A[i], B[i], C[i], n);
+        reward[i] = (float)((int64_t)(before - after));
+        done[i] = after == 0;
+        if (after == 0) {
+            reward[i] += solveBonus;
+            episodeMoves[i] = moves[i];
+            A[i] = full; B[i] = 0; C[i] = 0;
+            moves[i] = 0;
+            after = startDistance;
+        }
+        distance[i] = after;
+    }
+}
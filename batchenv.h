@@ -0,0 +1,55 @@
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include "threadpool.h"
+#include <cstdint>
+#include <vector>
+
+// Steps many independent n-disk games at once for automated agents.
+//
+// State is kept structure-of-arrays: peg[p][i] is a bitmask of the disks on
+// peg p of game i (bit k-1 = disk k, so the top disk is the lowest set bit).
+// step() applies one action per game with branch-free legality checks that
+// the compiler can vectorize, and shards the batch across a ThreadPool.
+class BatchEnv {
+public:
+    // actions: 0 A->B, 1 A->C, 2 B->A, 3 B->C, 4 C->A, 5 C->B
+    static const int NUM_ACTIONS = 6;
+    static int actionFrom(int a);
+    static int actionTo(int a);
+    static int actionOf(int from, int to);
+
+    // optimal number of moves left to gather every disk on peg C
+    static uint64_t distanceToGoal(uint64_t a, uint64_t b, uint64_t c, int n);
+
+    BatchEnv(int batch, int numDisks, int threads = 0);
+
+    void reset();
+    // actions[i] is applied to game i; out-of-range actions count as illegal
+    void step(const uint8_t *actions);
+
+    int batch() const { return batchSize; }
+    int numDisks() const { return n; }
+
+    std::vector<uint64_t> peg[3];
+    std::vector<uint64_t> distance;   // optimal moves remaining
+    std::vector<uint32_t> moves;      // moves made in the current episode
+    std::vector<float>    reward;     // reward from the last step
+    std::vector<uint8_t>  legal;      // 1 if last action was legal
+    std::vector<uint8_t>  done;       // 1 if last step solved the game (it was then auto-reset)
+    std::vector<uint32_t> episodeMoves; // move count of the last finished episode
+
+    float illegalPenalty;
+    float solveBonus;
+
+private:
+    int batchSize;
+    int n;
+    uint64_t full;
+    uint64_t startDistance;
+    ThreadPool pool;
+
+    void stepRange(const uint8_t *actions, size_t b, size_t e);
+};
+
+#endif // BATCHENV_H
@@ -0,0 +1,130 @@
+#include "boardpainter.h"
+#include <algorithm>
+#include <cstdlib>
+
+static const int TX[3] = {125, 375, 625};
+
+static const QColor BG("#12121F");
+static const QColor TITLE("#89B4FA");
+static const QColor ROD("#585B70"), ROD_SEL("#89B4FA");
+static const QColor BASE("#3A3B50"), BASE_SEL("#585B70");
+static const QColor NAME("#CDD6F4"), NAME_SEL("#F5A623"), HINT("#585B70");
+static const QColor LABEL("#1E1E2E");
+
+BoardPainter::BoardPainter(int numDisks)
+    : n(std::max(1,numDisks)),
+      bgBrush(BG), shadowBrush(QColor(0,0,0,90)), shineBrush(QColor(255,255,255,55)),
+      titleFont("Arial",15,QFont::Bold), nameFont("Arial",20,QFont::Bold),
+      hintFont("Arial",8), labelFont("Arial",9,QFont::Bold), selFont("Arial",9,QFont::Bold)
+{
+    bodyBrush.resize(n+1);
+    selBrush.resize(n+1);
+    bodyPen.resize(n+1);
+    for(int sz=1;sz<=n;sz++){
+        QColor col=diskColor(sz);
+        bodyBrush[sz]=QBrush(col);
+        selBrush[sz]=QBrush(col.lighter(120));
+        bodyPen[sz]=QPen(col.darker(140),1.5);
+    }
+}
+
+int BoardPainter::towerX(int i)          { return TX[i]; }
+int BoardPainter::diskH(int n)           { return std::max(2,std::min((int)DISK_H,(ROD_H-20)/n)); }
+int BoardPainter::diskThick(int n)       { int h=diskH(n); return h>=12 ? h-4 : std::max(1,h-1); }
+int BoardPainter::diskW(int sz, int n) {
+    float r = (float)sz / n;
+    return MIN_DISK_W + (int)((MAX_DISK_W-MIN_DISK_W)*r);
+}
+int BoardPainter::towerAtX(int x){
+    for(int i=0;i<3;i++) if(std::abs(x-TX[i])<130) return i;
+    return -1;
+}
+
+QColor BoardPainter::diskColor(int sz, int n) {
+    static const QColor p[] = {
+        QColor("#FF6B6B"),QColor("#FF922B"),QColor("#FCC419"),
+        QColor("#51CF66"),QColor("#20C997"),QColor("#339AF0"),
+        QColor("#845EF7"),QColor("#F06595")
+    };
+    if(n<=8) return p[(sz-1)%8];
+    // larger towers: same red → violet sweep, spread evenly over n disks
+    return QColor::fromHsv((sz-1)*330/(n-1),180,245);
+}
+
+QRect BoardPainter::rodRect(int i) const {
+    int cx=towerX(i), by=baseY();
+    return QRect(cx-MAX_DISK_W/2-10, by-ROD_H-26, MAX_DISK_W+20, ROD_H+BASE_H+72);
+}
+
+QRect BoardPainter::diskRect(QPointF c, int disk) const {
+    int dw=diskW(disk), th=diskThick();
+    return QRect((int)c.x()-dw/2, (int)c.y()-th/2, dw, th);
+}
+
+QPointF BoardPainter::arcPos(float sx, float sy, float ex, float ey, float t){
+    float midX=(sx+ex)/2.0f;
+    float x=(1-t)*(1-t)*sx + 2*(1-t)*t*midX  + t*t*ex;
+    float y=(1-t)*(1-t)*sy + 2*(1-t)*t*ARC_Y + t*t*ey;
+    return QPointF(x,y);
+}
+
+void BoardPainter::paintBackground(QPainter &p, const QRect &dirty) const {
+    p.fillRect(dirty,bgBrush);
+    QRect title(0,0,SCENE_W,40);
+    if(dirty.intersects(title)){
+        p.setFont(titleFont);
+        p.setPen(TITLE);
+        p.drawText(title,Qt::AlignCenter,"TOWER  OF  HANOI");
+    }
+}
+
+void BoardPainter::paintDisk(QPainter &p, int sz, int x, int y, bool sel) const {
+    int dw=diskW(sz), th=diskThick();
+    p.fillRect(x+3,y+3,dw,th,shadowBrush);
+    p.setPen(sel?QPen(NAME_SEL,2.5):bodyPen[sz]);
+    p.setBrush(sel?selBrush[sz]:bodyBrush[sz]);
+    p.drawRect(x,y,dw,th);
+    if(th>=6) p.fillRect(x+4,y+2,dw-8,std::max(1,th/4),shineBrush);
+    if(th>=12){
+        p.setPen(LABEL);
+        p.setFont(labelFont);
+        p.drawText(QRect(x,y,dw,th),Qt::AlignCenter,QString::number(sz));
+    }
+}
+
+void BoardPainter::paintRod(QPainter &p, int i, const int *disks, int count, bool sel, bool selTop) const {
+    static const char *lbs[3]={"A","B","C"};
+    static const char *hts[3]={"SOURCE","AUXILIARY","DESTINATION"};
+    int cx=towerX(i), by=baseY();
+
+    if(sel){
+        p.setPen(QPen(ROD_SEL,2,Qt::DashLine));
+        p.setBrush(QColor(137,180,250,22));
+        p.drawRect(cx-MAX_DISK_W/2-8,by-ROD_H,MAX_DISK_W+16,ROD_H+BASE_H);
+    }
+    p.fillRect(cx-MAX_DISK_W/2-8,by,MAX_DISK_W+16,BASE_H,sel?BASE_SEL:BASE);
+    p.fillRect(cx-6,by-ROD_H,12,ROD_H,sel?ROD_SEL:ROD);
+
+    p.setFont(nameFont);
+    p.setPen(sel?NAME_SEL:NAME);
+    p.drawText(cx-12,by+BASE_H+30,lbs[i]);
+    p.setFont(hintFont);
+    p.setPen(HINT);
+    p.drawText(cx-36,by+BASE_H+42,hts[i]);
+    if(sel){
+        p.setFont(selFont);
+        p.setPen(NAME_SEL);
+        p.drawText(cx-28,by-ROD_H-6,"SELECTED");
+    }
+
+    int dh=diskH();
+    bool topSel=selTop&&count>0;
+    for(int k=0;k<count;k++)
+        paintDisk(p,disks[k],cx-diskW(disks[k])/2,by-(k+1)*dh,topSel&&k==count-1);
+    if(topSel){
+        int dw=diskW(disks[count-1]);
+        p.setPen(QPen(NAME_SEL,2.5));
+        p.setBrush(Qt::NoBrush);
+        p.drawRect(cx-dw/2-4,by-count*dh-4,dw+8,dh+4);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef BOARDPAINTER_H
+#define BOARDPAINTER_H
+
+#include <QPainter>
+#include <QBrush>
+#include <QPen>
+#include <QFont>
+#include <QColor>
+#include <QRect>
+#include <cstdint>
+#include <vector>
+
+// The board's look for QPainter targets, without any window: the same
+// background, title, rods, bases, labels, disks and arc as the scene that
+// MainWindow builds in drawTowers/drawDisks/onAnimStep, in scene coordinates
+// (SCENE_W x SCENE_H). Brushes, pens and fonts are made once per disk count.
+//
+// Used by BoardWidget and by hanoi_render, which keeps one instance per
+// worker thread. The geometry and the disk palette are the one definition
+// every renderer shares: MainWindow's scene and the dashboard tiles call the
+// static forms below instead of keeping copies.
+class BoardPainter {
+public:
+    explicit BoardPainter(int numDisks);
+
+    static const int SCENE_W    = 750;
+    static const int SCENE_H    = 400;
+    static const int ROD_H      = 270;
+    static const int BASE_H     = 14;
+    static const int DISK_H     = 26;
+    static const int MAX_DISK_W = 185;
+    static const int MIN_DISK_W = 38;
+    static constexpr float ARC_Y = 55.0f;
+
+    int    numDisks() const { return n; }
+    static int towerX(int i);
+    static int baseY() { return SCENE_H - 45; }
+    int    diskH() const                { return diskH(n); }
+    int    diskThick() const            { return diskThick(n); }
+    int    diskW(int sz) const          { return diskW(sz, n); }
+    QColor diskColor(int sz) const      { return diskColor(sz, n); }
+
+    // the same for any disk count n: pitch shrinks so the full stack fits
+    // the rod, thickness leaves a gap, widths and colours spread over n
+    static int    diskH(int n);
+    static int    diskThick(int n);
+    static int    diskW(int sz, int n);
+    static QColor diskColor(int sz, int n);
+    static int    towerAtX(int x);     // rod under scene x, or -1
+
+    QRect rodRect(int i) const;                    // everything paintRod touches
+    QRect diskRect(QPointF centre, int disk) const;
+
+    // Quadratic bezier from (sx,sy) to (ex,ey) with its control point at the
+    // arc peak, as in MainWindow::flightPos
+    static QPointF arcPos(float sx, float sy, float ex, float ey, float t);
+
+    void paintBackground(QPainter &p, const QRect &dirty) const;
+    // disks[0] is the bottom disk; sel frames the rod, selTop its top disk
+    void paintRod(QPainter &p, int i, const int *disks, int count, bool sel, bool selTop) const;
+    void paintDisk(QPainter &p, int sz, int x, int y, bool sel) const;
+
+private:
+    int n;
+    std::vector<QBrush> bodyBrush, selBrush;   // index = disk size
+    std::vector<QPen>   bodyPen;
+    QBrush bgBrush, shadowBrush, shineBrush;
+    QFont  titleFont, nameFont, hintFont, labelFont, selFont;
+};
+
+#endif // BOARDPAINTER_H
@@ -0,0 +1,66 @@
+#include "boardwidget.h"
+#include "mainwindow.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <algorithm>
+
+BoardWidget::BoardWidget(MainWindow *win, QWidget *parent)
+    : QWidget(parent), w(win), bp(win->game.numDisks)
+{
+    setFixedSize(MainWindow::SCENE_W, MainWindow::SCENE_H);
+    setAttribute(Qt::WA_OpaquePaintEvent);   // every dirty rect is filled with the background
+}
+
+void BoardWidget::updateRods(int a, int b){
+    update(bp.rodRect(a));
+    if(b!=a) update(bp.rodRect(b));
+}
+
+void BoardWidget::updateDisk(QPointF oldPos, QPointF newPos, int disk){
+    update(bp.diskRect(oldPos,disk).united(bp.diskRect(newPos,disk)).adjusted(-4,-4,6,6));
+}
+
+// rod i with its disks, leaving out the top `skip` (they are in the air)
+void BoardWidget::paintRod(QPainter &p, int i, int skip){
+    Tower &t=i==0?w->game.towerA:i==1?w->game.towerB:w->game.towerC;
+    std::vector<int> lst;
+    t.list(lst);
+
+    bool sel=(i==w->selectedTower);
+    bp.paintRod(p,i,lst.data(),(int)lst.size()-skip,sel,sel&&skip==0);
+}
+
+void BoardWidget::paintEvent(QPaintEvent *event){
+    ScopedProbe sp(w->probe, PerfProbe::PAINT);
+    if(bp.numDisks()!=w->game.numDisks) bp=BoardPainter(w->game.numDisks);
+
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing);
+    QRect dirty=event->rect();
+    bp.paintBackground(p,dirty);
+
+    // rods repaint only where dirty; each skips the disks currently in the air
+    int skip[3]={0,0,0};
+    for(const MainWindow::Flight &f:w->flights) skip[f.from]++;
+    for(int i=0;i<3;i++)
+        if(dirty.intersects(bp.rodRect(i))) paintRod(p,i,skip[i]);
+
+    for(const MainWindow::Flight &f:w->flights){
+        QRect r=bp.diskRect(w->flightPos(f,f.progress),f.disk);
+        if(dirty.intersects(r.adjusted(-4,-4,6,6))) bp.paintDisk(p,f.disk,r.x(),r.y(),false);
+    }
+
+    if(w->dragging){
+        QRect r=bp.diskRect(w->dragPos,w->dragDiskSz);
+        QColor col=bp.diskColor(w->dragDiskSz);
+        p.setPen(QPen(col.lighter(140),2));
+        p.setBrush(QColor(col.red(),col.green(),col.blue(),150));
+        p.drawRect(r);
+    }
+}
+
+void SceneView::wheelEvent(QWheelEvent *event){
+    w->zoomAt(event->angleDelta().y());
+    event->accept();
+}
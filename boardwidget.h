@@ -0,0 +1,59 @@
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include <QWidget>
+#include <QGraphicsView>
+#include "boardpainter.h"
+#include "perfprobe.h"
+
+class MainWindow;
+
+// Alternative to the QGraphicsScene board (toggle: F4). Paints straight from
+// MainWindow's game, flight and drag state through a BoardPainter rebuilt
+// when the disk count changes, in scene coordinates (the widget is
+// SCENE_W x SCENE_H). Mouse
+// input goes through MainWindow::eventFilter exactly like the view's, so
+// click, drag, queueing and the arc animation behave the same.
+//
+// Nothing is retained between frames; callers mark what changed:
+// updateRods() for the source and destination of a move, updateDisk() for a
+// disk in the air or the drag ghost.
+class BoardWidget : public QWidget {
+public:
+    BoardWidget(MainWindow *win, QWidget *parent);
+
+    void updateRods(int a, int b);
+    void updateDisk(QPointF oldPos, QPointF newPos, int disk);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    MainWindow *w;
+
+    BoardPainter bp;
+    void paintRod(QPainter &p, int i, int skip);
+};
+
+// QGraphicsView that reports its viewport paint time to MainWindow's probe,
+// so the offscreen harness can compare both renderers on the same stage.
+// The wheel zooms through MainWindow::zoomAt before QAbstractScrollArea can
+// hand it to the (hidden, but still ranged) scrollbars.
+class SceneView : public QGraphicsView {
+public:
+    SceneView(QGraphicsScene *scene, MainWindow *win, QWidget *parent, PerfProbe **probe)
+        : QGraphicsView(scene, parent), w(win), probe(probe) {}
+
+protected:
+    void paintEvent(QPaintEvent *event) override {
+        ScopedProbe sp(*probe, PerfProbe::PAINT);
+        QGraphicsView::paintEvent(event);
+    }
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    MainWindow *w;
+    PerfProbe **probe;
+};
+
+#endif // BOARDWIDGET_H
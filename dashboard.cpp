@@ -0,0 +1,263 @@
+#include "dashboard.h"
+#include "boardpainter.h"
+#include "movefile.h"
+#include "solver.h"
+#include <QGuiApplication>
+#include <QKeyEvent>
+#include <QPainter>
+#include <QScreen>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+static const double HOLD_S = 1.5;               // solved board stays up this long
+static const int    MAX_MOVES_PER_TICK = 64;    // bound on catch-up after a stall
+static const double CELL_ASPECT = 1.6;          // preferred width / height of a tile
+
+static const QColor WALL("#181825"), TILE("#12121F"), ROD("#585B70"), BASE("#3A3B50");
+static const QColor FAILED("#F38BA8"), STATS("#CDD6F4");
+
+Dashboard::Dashboard(const Options &opt, QWidget *parent)
+    : QWidget(parent), keepAll(false), replayMoves(opt.replay),
+      lastTickNs(0), frameCount(0), showStats(false), cols(1), cellW(1), cellH(1)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(320, 200);
+    setWindowTitle("Tower of Hanoi — Dashboard");
+
+    // the board's palette, looked up once per disk count
+    for(int n=1;n<=MAX_DISKS;n++){
+        palette[n].resize(n+1);
+        for(int sz=1;sz<=n;sz++) palette[n][sz]=BoardPainter::diskColor(sz,n);
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> u(0.0,1.0);
+    int lo=std::max(1,std::min(opt.minDisks,MAX_DISKS));
+    int hi=std::max(lo,std::min(opt.maxDisks,MAX_DISKS));
+    for(int i=0;i<opt.boards;i++){
+        boards.emplace_back();
+        DashBoard &b=boards.back();
+        b.replay = opt.replayDisks>0 && !replayMoves.empty() && (i&1);
+        b.n = b.replay ? std::min(opt.replayDisks,MAX_DISKS) : lo+(int)(u(rng)*(hi-lo+1))%(hi-lo+1);
+        b.speed = opt.movesPerSec*(0.75+0.5*u(rng));   // out of step with each other
+        restart(b);
+        b.hold = u(rng);                               // staggered start
+    }
+
+    ticker.setTimerType(Qt::PreciseTimer);
+    QScreen *scr = QGuiApplication::primaryScreen();
+    double hz = scr && scr->refreshRate()>1 ? scr->refreshRate() : 60.0;
+    ticker.setInterval(std::max(1,(int)std::lround(1000.0/hz)));
+    connect(&ticker, &QTimer::timeout, this, &Dashboard::tick);
+    clock.start();
+    ticker.start();
+}
+
+// ─── Simulation ───────────────────────────────────────────────────────────────
+void Dashboard::restart(DashBoard &b){
+    b.game.init(b.n);
+    b.peg[0]=fullTowerMask(b.n);
+    b.peg[1]=b.peg[2]=0;
+    b.next=0;
+    b.t=-1;
+    b.hold=0;
+    b.failed=false;
+}
+
+bool Dashboard::liftNext(DashBoard &b){
+    uint64_t total = b.replay ? replayMoves.size() : optimalMoveCount(b.n);
+    if(b.next>=total) return false;
+    int disk, from, to;
+    if(b.replay){
+        from=packedFrom(replayMoves[b.next]);
+        to=packedTo(replayMoves[b.next]);
+    } else optimalMove(b.n, b.next+1, disk, from, to);
+    if(from>2||to>2||from==to||!b.peg[from]){ b.failed=true; return false; }
+    uint64_t bit=b.peg[from]&(~b.peg[from]+1);
+    if(b.peg[to] && (b.peg[to]&(~b.peg[to]+1))<bit){ b.failed=true; return false; }
+    b.peg[from]&=~bit;
+    b.disk=__builtin_ctzll(bit)+1;
+    b.from=from;
+    b.to=to;
+    return true;
+}
+
+void Dashboard::land(DashBoard &b){
+    static const char *names[3]={"A","B","C"};
+    uint64_t bit=1ULL<<(b.disk-1);
+    b.t=-1;
+    if(!b.game.moveDisk(names[b.from],names[b.to])){
+        b.peg[b.from]|=bit;
+        b.failed=true;
+        return;
+    }
+    b.peg[b.to]|=bit;
+    b.next++;
+}
+
+void Dashboard::advance(DashBoard &b, double dt){
+    if(b.failed) return;
+    if(b.hold>0){
+        b.hold-=dt;
+        if(b.hold>0) return;
+        dt=-b.hold;
+        b.hold=0;
+        if(b.next) restart(b);   // finished board has been shown long enough
+    }
+    double left=dt*b.speed;      // in moves
+    for(int k=0;left>0&&k<MAX_MOVES_PER_TICK;k++){
+        if(b.t<0){
+            if(!liftNext(b)){ if(!b.failed) b.hold=HOLD_S; return; }
+            b.t=0;
+        }
+        double step=std::min(left,1.0-b.t);
+        b.t+=step;
+        left-=step;
+        if(b.t>=1.0) land(b);
+    }
+}
+
+void Dashboard::tick(){
+    int64_t now=clock.nsecsElapsed();
+    if(lastTickNs){
+        frameRing.push(now-lastTickNs);
+        if(keepAll) frameNs.push_back(now-lastTickNs);
+    }
+    double dt=std::min(0.1,(now-lastTickNs)/1e9);
+    lastTickNs=now;
+    for(DashBoard &b:boards) advance(b,dt);
+    frameCount++;
+    update();
+}
+
+// ─── Layout ───────────────────────────────────────────────────────────────────
+void Dashboard::layout(){
+    int nb=std::max(1,(int)boards.size());
+    cols=std::max(1,(int)std::lround(std::sqrt(nb*(double)width()/height()/CELL_ASPECT)));
+    cols=std::min(cols,nb);
+    int rows=(nb+cols-1)/cols;
+    cellW=std::max(1,width()/cols);
+    cellH=std::max(1,height()/rows);
+
+    // rods and bases never change; paint them once per size
+    qreal dpr=devicePixelRatioF();
+    background=QPixmap(size()*dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(WALL);
+    QPainter p(&background);
+    for(int i=0;i<(int)boards.size();i++){
+        QRect c=cellRect(i);
+        p.fillRect(c,TILE);
+        int baseH=std::max(2,c.height()/24), rodH=c.height()*3/4, rodW=std::max(2,c.width()/60);
+        int by=c.bottom()-baseH;
+        p.fillRect(c.x()+4,by,c.width()-8,baseH,BASE);
+        for(int k=0;k<3;k++){
+            int cx=c.x()+c.width()*(2*k+1)/6;
+            p.fillRect(cx-rodW/2,by-rodH,rodW,rodH,ROD);
+        }
+    }
+}
+
+QRect Dashboard::cellRect(int i) const {
+    return QRect((i%cols)*cellW, (i/cols)*cellH, cellW, cellH).adjusted(2,2,-2,-2);
+}
+
+int Dashboard::diskW(const DashBoard &b, int sz) const {
+    int maxW=cellW/3-6, minW=std::max(4,maxW/4);
+    return minW+(maxW-minW)*sz/b.n;
+}
+
+int Dashboard::pitch(const DashBoard &b) const {
+    return std::max(1,(cellH*3/4-6)/b.n);
+}
+
+void Dashboard::resizeEvent(QResizeEvent *){
+    layout();
+}
+
+void Dashboard::keyPressEvent(QKeyEvent *event){
+    if(event->key()==Qt::Key_F3){ showStats=!showStats; update(); }
+    else if(event->key()==Qt::Key_F11) setWindowState(windowState()^Qt::WindowFullScreen);
+    else QWidget::keyPressEvent(event);
+}
+
+// ─── Paint ────────────────────────────────────────────────────────────────────
+// One pass over every board: disks at rest from the peg bitmasks (bottom
+// disk = highest set bit), then the disk in the air on its arc.
+void Dashboard::paintEvent(QPaintEvent *){
+    QElapsedTimer pt;
+    pt.start();
+    QPainter p(this);
+    p.drawPixmap(0,0,background);
+
+    for(int i=0;i<(int)boards.size();i++){
+        const DashBoard &b=boards[i];
+        QRect c=cellRect(i);
+        int by=c.bottom()-std::max(2,c.height()/24);
+        int ph=pitch(b), th=ph>=4 ? ph-1 : ph;
+        const std::vector<QColor> &col=palette[b.n];
+        for(int k=0;k<3;k++){
+            int cx=c.x()+c.width()*(2*k+1)/6, level=0;
+            for(uint64_t m=b.peg[k];m;level++){
+                int sz=64-__builtin_clzll(m);
+                m&=~(1ULL<<(sz-1));
+                int dw=diskW(b,sz);
+                p.fillRect(cx-dw/2,by-(level+1)*ph,dw,th,col[sz]);
+            }
+        }
+        if(b.t>=0){
+            // same arc as MainWindow::flightPos, peaking at the top of the tile
+            float t=(float)b.t;
+            int sx=c.x()+c.width()*(2*b.from+1)/6, ex=c.x()+c.width()*(2*b.to+1)/6;
+            int sy=by-(__builtin_popcountll(b.peg[b.from])+1)*ph;
+            int ey=by-(__builtin_popcountll(b.peg[b.to])+1)*ph;
+            float x=sx+(ex-sx)*t;
+            float y=(1-t)*(1-t)*sy+2*(1-t)*t*c.top()+t*t*ey;
+            int dw=diskW(b,b.disk);
+            p.fillRect((int)x-dw/2,(int)y,dw,th,col[b.disk]);
+        }
+        if(b.failed){
+            p.setPen(QPen(FAILED,2));
+            p.setBrush(Qt::NoBrush);
+            p.drawRect(c.adjusted(1,1,-1,-1));
+        }
+    }
+
+    if(showStats&&frameRing.size()){
+        std::vector<int64_t> f, q;
+        for(int i=0;i<frameRing.size();i++) f.push_back(frameRing[i]);
+        for(int i=0;i<paintRing.size();i++) q.push_back(paintRing[i]);
+        std::sort(f.begin(),f.end());
+        std::sort(q.begin(),q.end());
+        double med=f[f.size()/2]/1e6, p99=f[std::min(f.size()-1,f.size()*99/100)]/1e6;
+        QString s=QString("%1 boards   %2 fps   frame p99 %3 ms   paint %4 ms")
+                      .arg(boards.size()).arg(1000.0/med,0,'f',0).arg(p99,0,'f',1)
+                      .arg(q.empty()?0.0:q[q.size()/2]/1e6,0,'f',2);
+        p.fillRect(QRect(0,0,360,22),QColor(0,0,0,170));
+        p.setPen(STATS);
+        p.setFont(QFont("Arial",9,QFont::Bold));
+        p.drawText(QRect(8,0,352,22),Qt::AlignVCenter,s);
+    }
+
+    int64_t ns=pt.nsecsElapsed();
+    paintRing.push(ns);
+    if(keepAll) paintNs.push_back(ns);
+}
+
+// ─── Stats ────────────────────────────────────────────────────────────────────
+void Dashboard::printStats(FILE *f) const {
+    auto pct=[](std::vector<int64_t> v, double q){
+        if(v.empty()) return 0.0;
+        std::sort(v.begin(),v.end());
+        return v[std::min(v.size()-1,(size_t)(v.size()*q))]/1e6;
+    };
+    double med=pct(frameNs,0.5);
+    fprintf(f,"%zu boards, %lld frames, interval %d ms\n", boards.size(), (long long)frameCount,
+            ticker.interval());
+    fprintf(f,"frame interval  median %7.2f ms  p99 %7.2f ms  max %7.2f ms  (%.1f fps)\n",
+            med, pct(frameNs,0.99), pct(frameNs,1.0), med>0 ? 1000.0/med : 0.0);
+    fprintf(f,"paint           median %7.2f ms  p99 %7.2f ms  max %7.2f ms\n",
+            pct(paintNs,0.5), pct(paintNs,0.99), pct(paintNs,1.0));
+}
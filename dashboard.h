@@ -0,0 +1,91 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <QWidget>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPixmap>
+#include <QColor>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "game.h"
+#include "perfprobe.h"
+
+// One tile of the dashboard: an independent Game plus what is needed to draw
+// it without walking the towers every frame.
+struct DashBoard {
+    Game     game;
+    int      n;
+    uint64_t peg[3];      // disks at rest, bit k-1 = disk k (kept beside game)
+    bool     replay;      // plays Dashboard::replayMoves instead of auto-solving
+    uint64_t next;        // moves applied so far
+    int      disk, from, to;
+    double   t;           // progress of the disk in the air, < 0 = none
+    double   speed;       // moves per second
+    double   hold;        // seconds left before (re)starting
+    bool     failed;      // replay hit a move the game rejected
+};
+
+// Grid of games for kiosks and demo walls (see hanoi_dashboard.cpp).
+//
+// There are no per-board timers: one ticker at the screen's refresh interval
+// advances every board by the measured frame time and requests a single
+// repaint, and paintEvent draws the whole grid in one pass (a cached pixmap of
+// the rods and bases, then the disks of every board). Boards move by elapsed
+// time rather than by tick count, so a late frame never slows the games.
+class Dashboard : public QWidget {
+public:
+    struct Options {
+        int    boards      = 100;
+        int    minDisks    = 3;
+        int    maxDisks    = 7;
+        double movesPerSec = 4.0;
+        std::vector<uint8_t> replay;   // one move per byte, packMove() format
+        int    replayDisks = 0;        // every other board replays when set
+    };
+
+    explicit Dashboard(const Options &opt, QWidget *parent = nullptr);
+
+    // frame interval / paint time samples; keepAll also retains every sample
+    bool keepAll;
+    std::vector<int64_t> frameNs, paintNs;
+    int64_t frames() const { return frameCount; }
+    void printStats(FILE *f) const;
+
+    static constexpr int MAX_DISKS = 10;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    std::deque<DashBoard> boards;   // never relocates, boards are built in place
+    std::vector<uint8_t>  replayMoves;
+
+    QTimer        ticker;
+    QElapsedTimer clock;
+    int64_t       lastTickNs;
+    int64_t       frameCount;
+    RingBuffer<int64_t, PerfProbe::RING> frameRing, paintRing;
+    bool          showStats;      // F3
+
+    // layout, rebuilt on resize
+    int     cols, cellW, cellH;
+    QPixmap background;
+    std::vector<QColor> palette[MAX_DISKS + 1];   // [n][size]
+
+    void tick();
+    void advance(DashBoard &b, double dt);
+    bool liftNext(DashBoard &b);
+    void land(DashBoard &b);
+    void restart(DashBoard &b);
+    void layout();
+
+    QRect cellRect(int i) const;
+    int   diskW(const DashBoard &b, int sz) const;
+    int   pitch(const DashBoard &b) const;
+};
+
+#endif // DASHBOARD_H
@@ -1,29 +1,45 @@
 #include "game.h"
+#include "multidisk.h"
 #include "tower.h"
 #include "move.h"
-#include <sstream>
+#include "moveformat.h"
+#include "trace.h"
 #include <cmath>
 
-Game::Game() : numDisks(3), moveCount(0) {
+Game::Game()
+    : numDisks(3), moveCount(0), rules(MoveRules::classic()),
+      copies(1), keepOrder(false),
+      solutionQueue(CountingAllocator<Move>(MEM_SOLUTION_QUEUE)),
+      undoStack(CountingAllocator<Move>(MEM_UNDO_STACK)),
+      moveLog(CountingAllocator<CountedString>(MEM_MOVE_LOG)),
+      hash(0), lastRepeat(-1) {
     towerA = Tower("A");
     towerB = Tower("B");
     towerC = Tower("C");
 }
 
 void Game::init(int n) {
+    TRACE_ZONE("Game::init");
     numDisks = n;
     moveCount = 0;
     moveLog.clear();
 
-    while (!towerA.disks.empty()) towerA.disks.pop();
-    while (!towerB.disks.empty()) towerB.disks.pop();
-    while (!towerC.disks.empty()) towerC.disks.pop();
+    towerA.clear();
+    towerB.clear();
+    towerC.clear();
     while (!undoStack.empty()) undoStack.pop();
     while (!solutionQueue.empty()) solutionQueue.pop();
 
+    if (copies < 1 || rules != MoveRules::classic()) copies = 1;
+    if (copies > Tower::MAX_COPIES) copies = Tower::MAX_COPIES;
+    hash = 0;
     for (int i = n; i >= 1; i--) {
-        towerA.push(i);
+        for (int c = 0; c < copies; c++) towerA.push(i, c);
+        hash ^= runKey(i, 0, copies, towerA.runs.back().labels);
     }
+    seenPositions.clear();
+    seenPositions.insert(hash, 0);
+    lastRepeat = -1;
 }
 
 Tower* Game::getTower(std::string name) {
@@ -33,31 +49,46 @@ Tower* Game::getTower(std::string name) {
     return nullptr;
 }
 
+int Game::pegIndex(const std::string &name) {
+    if (name == "A") return 0;
+    if (name == "B") return 1;
+    if (name == "C") return 2;
+    return -1;
+}
+
 bool Game::moveDisk(std::string from, std::string to) {
+    TRACE_ZONE("Game::moveDisk");
     Tower* src = getTower(from);
     Tower* dst = getTower(to);
 
     if (!src || !dst) return false;
+    int fi = pegIndex(from), ti = pegIndex(to);
+    if (!rules.allows(fi, ti)) return false;
     if (src->isEmpty()) return false;
 
     int diskSize = src->top();
     if (!dst->isEmpty() && dst->top() < diskSize) return false;
 
+    hashMove(diskSize, src, fi, dst, ti);
+    int label = src->topLabel();
     src->pop();
-    dst->push(diskSize);
+    dst->push(diskSize, label);
 
     Move m(from, to, diskSize);
     undoStack.push(m);
 
     moveCount++;
-    std::ostringstream oss;
-    oss << moveCount << ". Disk " << diskSize << ": " << from << " -> " << to;
-    moveLog.push_back(oss.str());
+    lastRepeat = seenPositions.insert(hash, moveCount);
+
+    char line[MOVE_LINE_MAX];
+    char *end = formatMoveText(line, moveCount, diskSize, fi, ti);
+    moveLog.emplace_back(line, end, CountingAllocator<char>(MEM_MOVE_LOG));
 
     return true;
 }
 
 void Game::undoMove() {
+    TRACE_ZONE("Game::undoMove");
     if (undoStack.empty()) return;
 
     Move m = undoStack.top();
@@ -66,22 +97,70 @@ void Game::undoMove() {
     Tower* src = getTower(m.to);
     Tower* dst = getTower(m.from);
 
+    // forget the position being left if this move was the first to reach it
+    if (seenPositions.find(hash) == moveCount) seenPositions.erase(hash);
+    hashMove(m.diskSize, src, pegIndex(m.to), dst, pegIndex(m.from));
+
+    int label = src->topLabel();
     src->pop();
-    dst->push(m.diskSize);
+    dst->push(m.diskSize, label);
 
     moveCount--;
+    int first = seenPositions.find(hash);
+    lastRepeat = (first >= 0 && first < moveCount) ? first : -1;
     if (!moveLog.empty()) moveLog.pop_back();
 }
 
 void Game::generateSolution(int n, std::string src, std::string aux, std::string dst) {
+    TRACE_ZONE_IF(n == numDisks, "Game::generateSolution");   // outermost call only
     if (n == 0) return;
+    static const char *names[3] = {"A", "B", "C"};
+    if (copies > 1) {
+        // runs move as blocks; the queue holds single disks
+        MultiStream blocks(n, copies, keepOrder, pegIndex(src), pegIndex(dst));
+        BlockMove b;
+        while (blocks.next(b))
+            for (int i = 0; i < b.count; i++) solutionQueue.push(Move(names[b.from], names[b.to], b.disk));
+        return;
+    }
+    if (rules.kind() != RULES_CLASSIC) {
+        // the src/aux/dst recursion only fits the classic rules
+        VariantSolver solver(rules, n);
+        VariantStream moves(solver, pegIndex(src), pegIndex(dst));
+        int disk, f, t;
+        while (moves.next(disk, f, t)) solutionQueue.push(Move(names[f], names[t], disk));
+        return;
+    }
     generateSolution(n - 1, src, dst, aux);
     solutionQueue.push(Move(src, dst, n));
     generateSolution(n - 1, aux, src, dst);
 }
 
 bool Game::isWon() {
-    return (int)towerC.disks.size() == numDisks;
+    if (towerC.size() != numDisks * copies) return false;
+    if (!keepOrder || copies == 1) return true;
+    uint64_t start = 0;   // labels of a run as init() stacked it
+    for (int c = 0; c < copies; c++) start = start << 4 | (uint64_t)c;
+    for (const DiskRun &r : towerC.runs)
+        if (r.labels != start) return false;
+    return true;
+}
+
+// XORs the move of the top disk of src onto dst into the position hash;
+// called before the towers change
+void Game::hashMove(int diskSize, Tower *src, int fi, Tower *dst, int ti) {
+    const DiskRun &f = src->runs.back();
+    int ct = dst->top() == diskSize ? dst->runs.back().count : 0;
+    uint64_t lt = ct ? dst->runs.back().labels : 0;
+    hash ^= runKey(diskSize, fi, f.count, f.labels) ^ runKey(diskSize, fi, f.count - 1, f.labels >> 4)
+          ^ runKey(diskSize, ti, ct, lt) ^ runKey(diskSize, ti, ct + 1, lt << 4 | (f.labels & 15));
+}
+
+// hash of one run: copies are interchangeable unless keepOrder makes their
+// order part of the position
+uint64_t Game::runKey(int diskSize, int peg, int count, uint64_t labels) const {
+    if (keepOrder && copies > 1) return Zobrist::key(diskSize, peg, count, labels);
+    return Zobrist::key(diskSize, peg, count);
 }
 
 void Game::reset(int n) {
@@ -3,20 +3,48 @@
 
 #include "tower.h"
 #include "move.h"
+#include "zobrist.h"
+#include "memstats.h"
+#include "variant.h"
+#include <cstdint>
+#include <deque>
 #include <queue>
 #include <stack>
 #include <vector>
 #include <string>
 
+typedef std::stack<Move, std::deque<Move, CountingAllocator<Move>>> MoveStack;
+typedef std::queue<Move, std::deque<Move, CountingAllocator<Move>>> MoveQueue;
+typedef std::vector<CountedString, CountingAllocator<CountedString>> MoveLog;
+
 class Game {
 public:
     Tower towerA, towerB, towerC;
     int numDisks;
     int moveCount;
 
-    std::queue<Move> solutionQueue;
-    std::stack<Move> undoStack;
-    std::vector<std::string> moveLog;
+    // allowed moves (variant.h); classic unless a variant is selected.
+    // moveDisk rejects anything else, generateSolution follows it.
+    MoveRules rules;
+
+    // identical disks per size (Tower::MAX_COPIES at most), read by init().
+    // With keepOrder every run must also end in its starting order. Copies
+    // need the classic rules: MultiStream only solves that puzzle, so init()
+    // falls back to one copy per size while a variant is selected.
+    int copies;
+    bool keepOrder;
+
+    // all three are charged to their own MemTag (see memstats.h)
+    MoveQueue solutionQueue;
+    MoveStack undoStack;
+    MoveLog moveLog;
+
+    // Zobrist hash of the current position, updated by moveDisk/undoMove
+    uint64_t hash;
+    // position hash -> move number it was first reached at (current history only)
+    RepeatIndex seenPositions;
+    // move number the current position was first seen at, or -1 if it is new
+    int lastRepeat;
 
     Game();
     void init(int n);
@@ -26,6 +54,11 @@ public:
     bool isWon();
     void reset(int n);
     Tower* getTower(std::string name);
+    static int pegIndex(const std::string &name);
+
+private:
+    void hashMove(int diskSize, Tower *src, int fi, Tower *dst, int ti);
+    uint64_t runKey(int diskSize, int peg, int count, uint64_t labels) const;
 };
 
 #endif // GAME_H finish
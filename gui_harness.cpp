@@ -0,0 +1,334 @@
+// Offscreen GUI performance harness.
+//
+//   hanoi_gui_harness [--script file] [--json out.json]
+//                     [--baseline base.json] [--threshold 0.25]
+//                     [--trace trace.json] [--renderer scene|painter|both]
+//
+// Runs MainWindow under Qt's offscreen platform, replays a script of mouse
+// presses/drags/releases (delivered through MainWindow::eventFilter) and
+// button clicks, and records per-call times for redraw, doMove, onAnimStep and
+// finishMove, the scene item count and event-loop latency. With --baseline the
+// exit status is 1 if any stage's median got slower by more than `threshold`.
+// --trace dumps the trace zones as Chrome trace-event JSON (HANOI_TRACE builds).
+// --renderer picks the board (QGraphicsScene view or the QPainter BoardWidget);
+// "both" replays the script once per renderer and reports each stage twice,
+// prefixed "scene/" and "painter/", so the paint stage can be compared.
+// Cold-start phases (process start to first frame) are reported as
+// "startup/<phase>" rows, one sample each, so baselines catch those too.
+//
+// Script lines (scene coordinates, '#' starts a comment):
+//   disks N | reset | undo | autosolve
+//   press X Y | move X Y | release X Y | click X Y | drag X1 Y1 X2 Y2 [steps]
+//   wait MS | idle [TIMEOUT_MS] | solve-interval MS | anim-interval MS
+
+#include "mainwindow.h"
+#include "perfprobe.h"
+#include "startup.h"
+#include "trace.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMouseEvent>
+#include <QStandardPaths>
+#include <QTimer>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+static const char *DEFAULT_SCRIPT =
+    "disks 6\n"
+    "reset\n"
+    "anim-interval 16\n"
+    "click 125 300\nclick 375 300\nidle\n"          // A -> B by clicks
+    "drag 125 300 625 300 8\nidle\n"                 // A -> C by drag
+    "drag 375 300 625 300 8\nidle\n"                 // B -> C
+    "undo\nundo\nundo\n"
+    "solve-interval 20\n"
+    "autosolve\nidle 120000\n";
+
+struct StageStats {
+    size_t count = 0;
+    double medianUs = 0, p99Us = 0, maxUs = 0;
+};
+
+static StageStats summarize(std::vector<int64_t> v) {
+    StageStats s;
+    if (v.empty()) return s;
+    std::sort(v.begin(), v.end());
+    s.count = v.size();
+    s.medianUs = v[v.size() / 2] / 1000.0;
+    s.p99Us = v[std::min(v.size() - 1, (size_t)(v.size() * 0.99))] / 1000.0;
+    s.maxUs = v.back() / 1000.0;
+    return s;
+}
+
+class GuiHarness {
+public:
+    explicit GuiHarness(MainWindow &win) : itemsMax(0), w(win), lastTick(0) {
+        probe.keepAll = true;
+        w.setPerfProbe(&probe);
+
+        // event-loop latency: how late a 5 ms timer actually fires
+        lagTimer.setTimerType(Qt::PreciseTimer);
+        lagTimer.setInterval(5);
+        QObject::connect(&lagTimer, &QTimer::timeout, [this] {
+            int64_t now = clock.nsecsElapsed();
+            if (lastTick) lag.push_back(std::max<int64_t>(0, now - lastTick - 5000000));
+            lastTick = now;
+            if (lag.size() % 10 == 0) sampleItems();
+        });
+
+        // the win dialog is modal; dismiss it so replay keeps going
+        dialogKiller.setInterval(50);
+        QObject::connect(&dialogKiller, &QTimer::timeout, [] {
+            if (QWidget *m = QApplication::activeModalWidget())
+                if (QDialog *d = qobject_cast<QDialog*>(m)) d->reject();
+        });
+    }
+
+    bool run(const QStringList &script, QString &err) {
+        clock.start();
+        lagTimer.start();
+        dialogKiller.start();
+        int lineNo = 0;
+        for (const QString &raw : script) {
+            lineNo++;
+            QString line = raw.section('#', 0, 0).trimmed();
+            if (line.isEmpty()) continue;
+            QStringList t = line.split(' ', Qt::SkipEmptyParts);
+            if (!command(t)) {
+                err = QString("line %1: cannot run '%2'").arg(lineNo).arg(line);
+                return false;
+            }
+            sampleItems();
+        }
+        wallMs = clock.elapsed();
+        lagTimer.stop();
+        dialogKiller.stop();
+        return true;
+    }
+
+    PerfProbe probe;
+    std::vector<int64_t> lag;
+    int itemsMax;
+    qint64 wallMs = 0;
+
+private:
+    MainWindow &w;
+    QTimer lagTimer, dialogKiller;
+    QElapsedTimer clock;
+    int64_t lastTick;
+
+    void sampleItems() {
+        itemsMax = std::max(itemsMax, (int)w.scene->items().size());
+    }
+
+    void mouse(QEvent::Type type, double x, double y) {
+        // the painter board is laid out in scene coordinates already
+        QWidget *target = w.painterMode ? (QWidget*)w.board : w.view;
+        QPointF vp = w.painterMode ? QPointF(x, y) : QPointF(w.view->mapFromScene(QPointF(x, y)));
+        Qt::MouseButtons held = type == QEvent::MouseButtonRelease ? Qt::NoButton : Qt::LeftButton;
+        QMouseEvent ev(type, vp, target->mapToGlobal(vp.toPoint()), Qt::LeftButton, held, Qt::NoModifier);
+        QApplication::sendEvent(target, &ev);
+    }
+
+    void waitMs(int ms) {
+        QElapsedTimer t;
+        t.start();
+        while (t.elapsed() < ms) QApplication::processEvents(QEventLoop::AllEvents, 5);
+    }
+
+    bool waitIdle(int timeoutMs) {
+        QElapsedTimer t;
+        t.start();
+        while (w.animating || w.autoSolveTimer->isActive()) {
+            if (t.elapsed() > timeoutMs) return false;
+            QApplication::processEvents(QEventLoop::AllEvents, 5);
+        }
+        return true;
+    }
+
+    bool command(const QStringList &t) {
+        const QString &c = t[0];
+        auto num = [&](int i) { return i < t.size() ? t[i].toDouble() : 0.0; };
+        if (c == "disks" && t.size() == 2) {
+            int n = t[1].toInt();
+            if (n < 2 || n > w.comboDiskCount->count() + 1) return false;
+            w.comboDiskCount->setCurrentIndex(n - 2);
+        } else if (c == "reset") {
+            w.btnReset->click();
+        } else if (c == "undo") {
+            w.btnUndo->click();
+        } else if (c == "autosolve") {
+            w.btnAutoSolve->click();
+        } else if (c == "press" && t.size() == 3) {
+            mouse(QEvent::MouseButtonPress, num(1), num(2));
+        } else if (c == "move" && t.size() == 3) {
+            mouse(QEvent::MouseMove, num(1), num(2));
+        } else if (c == "release" && t.size() == 3) {
+            mouse(QEvent::MouseButtonRelease, num(1), num(2));
+        } else if (c == "click" && t.size() == 3) {
+            mouse(QEvent::MouseButtonPress, num(1), num(2));
+            mouse(QEvent::MouseButtonRelease, num(1), num(2));
+        } else if (c == "drag" && (t.size() == 5 || t.size() == 6)) {
+            int steps = t.size() == 6 ? std::max(1, t[5].toInt()) : 8;
+            mouse(QEvent::MouseButtonPress, num(1), num(2));
+            for (int i = 1; i <= steps; i++) {
+                double f = (double)i / steps;
+                mouse(QEvent::MouseMove, num(1) + (num(3) - num(1)) * f, num(2) + (num(4) - num(2)) * f);
+                QApplication::processEvents();
+            }
+            mouse(QEvent::MouseButtonRelease, num(3), num(4));
+        } else if (c == "wait" && t.size() == 2) {
+            waitMs(t[1].toInt());
+        } else if (c == "idle") {
+            return waitIdle(t.size() == 2 ? t[1].toInt() : 10000);
+        } else if (c == "solve-interval" && t.size() == 2) {
+            w.autoSolveTimer->setInterval(t[1].toInt());
+        } else if (c == "anim-interval" && t.size() == 2) {
+            w.animTimer->setInterval(t[1].toInt());
+        } else {
+            return false;
+        }
+        QApplication::processEvents();
+        return true;
+    }
+};
+
+// ─── Baseline / JSON ──────────────────────────────────────────────────────────
+static std::map<std::string, double> readBaseline(const char *path) {
+    std::map<std::string, double> m;
+    FILE *f = fopen(path, "r");
+    if (!f) return m;
+    char line[1024];
+    while (fgets(line, sizeof line, f)) {
+        const char *n = strstr(line, "\"name\":\"");
+        const char *med = strstr(line, "\"median_us\":");
+        if (!n || !med) continue;
+        n += 8;
+        const char *e = strchr(n, '"');
+        if (e) m[std::string(n, e)] = atof(med + 12);
+    }
+    fclose(f);
+    return m;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hanoi_gui_harness [--script file] [--json out.json]\n"
+                    "                         [--baseline base.json] [--threshold 0.25]\n"
+                    "                         [--trace trace.json] [--renderer scene|painter|both]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[]) {
+    startupMark("main");
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QStandardPaths::setTestModeEnabled(true);   // keep the user's saved session out of it
+
+    const char *scriptPath = nullptr, *jsonPath = nullptr, *basePath = nullptr;
+    const char *tracePath = nullptr, *renderer = "scene";
+    double threshold = 0.25;
+    for (int i = 1; i < argc; i++) {
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (!strcmp(argv[i], "--script"))    scriptPath = val();
+        else if (!strcmp(argv[i], "--json"))      jsonPath = val();
+        else if (!strcmp(argv[i], "--baseline"))  basePath = val();
+        else if (!strcmp(argv[i], "--threshold")) threshold = atof(val());
+        else if (!strcmp(argv[i], "--trace"))     tracePath = val();
+        else if (!strcmp(argv[i], "--renderer"))  renderer = val();
+        else usage();
+    }
+    std::vector<bool> modes;   // painterMode per pass
+    if      (!strcmp(renderer, "scene"))   modes = {false};
+    else if (!strcmp(renderer, "painter")) modes = {true};
+    else if (!strcmp(renderer, "both"))    modes = {false, true};
+    else usage();
+
+    QApplication app(argc, argv);
+    app.setApplicationName("TowerOfHanoi-harness");
+    app.setStyle("Fusion");
+    startupMark("QApplication");
+
+    QString script = DEFAULT_SCRIPT;
+    if (scriptPath) {
+        QFile f(scriptPath);
+        if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            fprintf(stderr, "hanoi_gui_harness: cannot read %s\n", scriptPath);
+            return 2;
+        }
+        script = QString::fromUtf8(f.readAll());
+    }
+
+    MainWindow w;
+    startupMark("MainWindow");
+    w.show();
+    startupMark("show");
+    QApplication::processEvents();
+
+    struct Row { std::string name; StageStats s; };
+    std::vector<Row> rows;
+    int itemsMax = 0;
+    qint64 wallMs = 0;
+    for (bool painter : modes) {
+        w.setPainterBoard(painter);
+        QApplication::processEvents();
+        GuiHarness h(w);
+        QString err;
+        if (!h.run(script.split('\n'), err)) {
+            fprintf(stderr, "hanoi_gui_harness: %s\n", qPrintable(err));
+            return 2;
+        }
+        std::string prefix = modes.size() > 1 ? (painter ? "painter/" : "scene/") : "";
+        for (int s = 0; s < PerfProbe::STAGE_COUNT; s++)
+            rows.push_back({prefix + PerfProbe::stageName(s), summarize(h.probe.samples[s])});
+        rows.push_back({prefix + "eventLoopLag", summarize(h.lag)});
+        itemsMax = std::max(itemsMax, h.itemsMax);
+        wallMs += h.wallMs;
+        w.setPerfProbe(nullptr);
+    }
+    for (const StartupPhase &p : startupPhases())
+        rows.push_back({std::string("startup/") + p.name, summarize({(int64_t)(p.ms * 1e6)})});
+
+    std::map<std::string, double> base;
+    if (basePath) base = readBaseline(basePath);
+
+    int regressions = 0;
+    printf("%-26s %8s %12s %12s %12s\n", "stage", "calls", "median us", "p99 us", "max us");
+    for (const Row &r : rows) {
+        printf("%-26s %8zu %12.1f %12.1f %12.1f", r.name.c_str(), r.s.count, r.s.medianUs,
+               r.s.p99Us, r.s.maxUs);
+        auto it = base.find(r.name);
+        if (it != base.end() && it->second > 0 && r.s.count) {
+            double delta = r.s.medianUs / it->second - 1.0;
+            bool bad = delta > threshold;
+            regressions += bad;
+            printf("  %+6.1f%%%s", delta * 100, bad ? "  REGRESSION" : "");
+        }
+        printf("\n");
+    }
+    printf("scene items                max %d\nwall time                  %lld ms\n", itemsMax, (long long)wallMs);
+
+    if (jsonPath) {
+        FILE *f = fopen(jsonPath, "w");
+        if (!f) { perror(jsonPath); return 2; }
+        fprintf(f, "{\"stages\":[\n");
+        for (size_t i = 0; i < rows.size(); i++)
+            fprintf(f, "{\"name\":\"%s\",\"count\":%zu,\"median_us\":%.2f,\"p99_us\":%.2f,\"max_us\":%.2f}%s\n",
+                    rows[i].name.c_str(), rows[i].s.count, rows[i].s.medianUs, rows[i].s.p99Us,
+                    rows[i].s.maxUs, i + 1 < rows.size() ? "," : "");
+        fprintf(f, "],\n\"scene_items_max\":%d,\n\"wall_ms\":%lld}\n", itemsMax, (long long)wallMs);
+        fclose(f);
+    }
+    if (tracePath && !traceWriteChrome(tracePath))
+        fprintf(stderr, "hanoi_gui_harness: %s\n", traceEnabled() ? "cannot write trace"
+                                                                  : "built without HANOI_TRACE");
+    if (regressions) {
+        printf("%d stage(s) regressed by more than %.0f%%\n", regressions, threshold * 100);
+        return 1;
+    }
+    return 0;
+}
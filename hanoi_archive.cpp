@@ -0,0 +1,163 @@
+// Creates and browses HNMA move archives (see movearchive.h).
+//
+//   hanoi_archive pack   --disks n [--every K] out.hnma   optimal solution
+//   hanoi_archive import [--every K] moves.hnmv out.hnma  packed move file
+//   hanoi_archive info   file.hnma
+//   hanoi_archive moves  file.hnma first [count]          move-log lines (1-based)
+//   hanoi_archive state  file.hnma k                      position after k moves
+
+#include "movearchive.h"
+#include "movefile.h"
+#include "moveformat.h"
+#include "outbuf.h"
+#include "solver.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_archive pack --disks n [--every K] out.hnma\n"
+            "       hanoi_archive import [--every K] moves.hnmv out.hnma\n"
+            "       hanoi_archive info file.hnma\n"
+            "       hanoi_archive moves file.hnma first [count]\n"
+            "       hanoi_archive state file.hnma k\n");
+    exit(2);
+}
+
+static int cmdPack(int n, uint32_t every, const char *out) {
+    if (n < 1 || n > 40) { fprintf(stderr, "hanoi_archive: --disks must be 1..40\n"); return 2; }
+    uint64_t full = fullTowerMask(n);
+    uint64_t start[3] = {full, 0, 0}, target[3] = {0, 0, full};
+    MoveArchiveWriter w;
+    if (!w.open(out, n, start, target, every)) { perror(out); return 1; }
+    for (uint64_t k = 1; k <= optimalMoveCount(n); k++) {
+        int d, f, t;
+        optimalMove(n, k, d, f, t);
+        w.append(f, t);
+    }
+    if (!w.close()) { fprintf(stderr, "hanoi_archive: write failed\n"); return 1; }
+    return 0;
+}
+
+static int cmdImport(uint32_t every, const char *in, const char *out) {
+    FILE *f = fopen(in, "rb");
+    if (!f) { perror(in); return 1; }
+    MoveFileHeader h;
+    if (fread(&h, sizeof h, 1, f) != 1 || !isMoveFileHeader(&h, sizeof h)) {
+        fprintf(stderr, "hanoi_archive: %s is not a packed move file\n", in);
+        fclose(f);
+        return 1;
+    }
+    uint64_t full = fullTowerMask(h.numDisks);
+    uint64_t start[3] = {full, 0, 0}, target[3] = {0, 0, full};
+    MoveArchiveWriter w;
+    if (!w.open(out, h.numDisks, start, target, every)) { perror(out); fclose(f); return 1; }
+
+    std::vector<uint8_t> buf(1 << 20);
+    uint64_t done = 0;
+    while (done < h.moveCount) {
+        size_t got = fread(buf.data(), 1, buf.size(), f);
+        if (got == 0) break;
+        for (size_t i = 0; i < got && done < h.moveCount; i++) {
+            for (int half = 0; half < 2 && done < h.moveCount; half++, done++) {
+                uint8_t nib = half ? buf[i] >> 4 : buf[i] & 15;
+                if (!w.append(packedFrom(nib), packedTo(nib))) {
+                    fprintf(stderr, "hanoi_archive: illegal move %llu\n", (unsigned long long)done + 1);
+                    fclose(f);
+                    return 1;
+                }
+            }
+        }
+    }
+    fclose(f);
+    if (done < h.moveCount) fprintf(stderr, "hanoi_archive: input truncated at %llu moves\n",
+                                    (unsigned long long)done);
+    if (!w.close()) { fprintf(stderr, "hanoi_archive: write failed\n"); return 1; }
+    return 0;
+}
+
+static void printPegs(const uint64_t peg[3], int n) {
+    for (int p = 0; p < 3; p++) {
+        printf("%c:", 'A' + p);
+        for (int k = n; k >= 1; k--)
+            if (peg[p] >> (k - 1) & 1) printf(" %d", k);
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) usage();
+    std::string cmd = argv[1];
+    int n = 0;
+    uint32_t every = 4096;
+    std::vector<const char*> pos;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--disks") && i + 1 < argc) n = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--every") && i + 1 < argc) every = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else pos.push_back(argv[i]);
+    }
+    if (every == 0) usage();
+
+    if (cmd == "pack"   && pos.size() == 1) return cmdPack(n, every, pos[0]);
+    if (cmd == "import" && pos.size() == 2) return cmdImport(every, pos[0], pos[1]);
+
+    if (pos.empty()) usage();
+    MoveArchiveReader r;
+    if (!r.open(pos[0])) { fprintf(stderr, "hanoi_archive: %s\n", r.error().c_str()); return 1; }
+    const MoveArchiveHeader &h = r.header();
+
+    if (cmd == "info" && pos.size() == 1) {
+        uint64_t fin[3];
+        if (!r.stateAt(r.moveCount(), fin)) {
+            fprintf(stderr, "hanoi_archive: %s holds an illegal move\n", pos[0]);
+            return 1;
+        }
+        bool reached = fin[0] == h.target[0] && fin[1] == h.target[1] && fin[2] == h.target[2];
+        printf("disks        %d\n", h.numDisks);
+        printf("moves        %llu\n", (unsigned long long)h.moveCount);
+        printf("block        %u moves\n", h.blockMoves);
+        printf("checkpoints  %llu (every %u moves)\n",
+               (unsigned long long)h.checkpointCount, h.checkpointEvery);
+        printf("target       %s\n", reached ? "reached" : "not reached");
+        return 0;
+    }
+    if (cmd == "moves" && (pos.size() == 2 || pos.size() == 3)) {
+        uint64_t first = strtoull(pos[1], nullptr, 10);
+        uint64_t count = pos.size() == 3 ? strtoull(pos[2], nullptr, 10) : 1;
+        if (first < 1 || first > r.moveCount()) { fprintf(stderr, "hanoi_archive: no such move\n"); return 1; }
+        if (count > r.moveCount() - first + 1) count = r.moveCount() - first + 1;
+        uint64_t peg[3];
+        if (!r.stateAt(first - 1, peg)) {
+            fprintf(stderr, "hanoi_archive: %s holds an illegal move before move %llu\n",
+                    pos[0], (unsigned long long)first);
+            return 1;
+        }
+        OutputBuffer out(stdout);
+        for (uint64_t k = first; k < first + count; k++) {
+            uint8_t nib = r.packed(k - 1);
+            int f = packedFrom(nib), t = packedTo(nib), d;
+            if (!applyPegMove(peg, f, t, &d)) {
+                out.flush();
+                fprintf(stderr, "hanoi_archive: move %llu in %s is illegal\n", (unsigned long long)k, pos[0]);
+                return 1;
+            }
+            char *p = out.reserve(MOVE_LINE_MAX);
+            p = formatMoveText(p, k, d, f, t);
+            *p++ = '\n';
+            out.commit(p);
+        }
+        out.flush();
+        return out.ok() ? 0 : 1;
+    }
+    if (cmd == "state" && pos.size() == 2) {
+        uint64_t k = strtoull(pos[1], nullptr, 10);
+        uint64_t peg[3];
+        if (!r.stateAt(k, peg)) { fprintf(stderr, "hanoi_archive: no such move\n"); return 1; }
+        printPegs(peg, h.numDisks);
+        return 0;
+    }
+    usage();
+}
@@ -0,0 +1,644 @@
+// Micro-benchmarks for the rules engine.
+//
+//   hanoi_bench [--samples N] [--filter text] [--json out.json]
+//               [--baseline base.json] [--threshold 0.10]
+//   hanoi_bench --check
+//
+// Every benchmark runs warmup samples, then N timed samples; each sample times
+// a fixed number of operations and reports per-op nanoseconds. Results show the
+// median and p99 over samples plus heap allocations per op, counted by the
+// replaced global operator new below. With --baseline, any benchmark whose
+// median is more than `threshold` slower than the stored one is a regression
+// and the exit status is 1.
+//
+// --check instead verifies the duplicate-disk and variant-rules solvers and
+// positionDistance() against a breadth-first search of every position for the
+// small cases, and the variant streams against their reference recursions; it
+// exits 1 on a mismatch.
+
+#include "batchenv.h"
+#include "game.h"
+#include "multidisk.h"
+#include "solver.h"
+#include "tower.h"
+#include "variant.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// ─── Allocation counting ──────────────────────────────────────────────────────
+static std::atomic<uint64_t> g_allocs(0);
+
+void* operator new(size_t sz) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = malloc(sz ? sz : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t sz) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = malloc(sz ? sz : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t sz, const std::nothrow_t&) noexcept {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    return malloc(sz ? sz : 1);
+}
+void* operator new[](size_t sz, const std::nothrow_t&) noexcept {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    return malloc(sz ? sz : 1);
+}
+void operator delete(void *p) noexcept           { free(p); }
+void operator delete[](void *p) noexcept         { free(p); }
+void operator delete(void *p, size_t) noexcept   { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// ─── Harness ──────────────────────────────────────────────────────────────────
+struct BenchResult {
+    std::string name;
+    uint64_t opsPerSample;
+    double medianNs, p99Ns, minNs;
+    double allocsPerOp;
+};
+
+struct BenchOptions {
+    int samples = 31;
+    int warmup = 3;
+    std::string filter;
+};
+
+static volatile int g_sink;   // keeps results alive
+
+static BenchResult runBench(const BenchOptions &opt, const std::string &name, uint64_t ops,
+                            const std::function<void()> &setup,
+                            const std::function<void()> &body) {
+    std::vector<double> perOp;
+    uint64_t allocs = 0;
+    for (int s = 0; s < opt.warmup + opt.samples; s++) {
+        setup();
+        uint64_t a0 = g_allocs.load(std::memory_order_relaxed);
+        auto t0 = std::chrono::steady_clock::now();
+        body();
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t a1 = g_allocs.load(std::memory_order_relaxed);
+        if (s < opt.warmup) continue;
+        perOp.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)ops);
+        allocs += a1 - a0;
+    }
+    std::sort(perOp.begin(), perOp.end());
+    BenchResult r;
+    r.name = name;
+    r.opsPerSample = ops;
+    r.minNs = perOp.front();
+    r.medianNs = perOp[perOp.size() / 2];
+    r.p99Ns = perOp[std::min(perOp.size() - 1, (size_t)(perOp.size() * 0.99))];
+    r.allocsPerOp = (double)allocs / (double)(ops * (uint64_t)opt.samples);
+    return r;
+}
+
+// ─── Benchmarks ───────────────────────────────────────────────────────────────
+static const char *PEGS[3] = {"A", "B", "C"};
+
+static std::vector<Move> optimalMoves(int n) {
+    std::vector<Move> v;
+    for (uint64_t k = 1; k <= optimalMoveCount(n); k++) {
+        int d, f, t;
+        optimalMove(n, k, d, f, t);
+        v.push_back(Move(PEGS[f], PEGS[t], d));
+    }
+    return v;
+}
+
+// Reference recursions for the variants, appending to a vector as the
+// textbook definitions do; the streamed generators are measured against them.
+static void cyclicRef(int n, int x, int y, std::vector<Move> &out) {   // y is x's successor or predecessor
+    if (n == 0) return;
+    int z = 3 - x - y;
+    if ((x + 1) % 3 == y) {            // one step forward
+        cyclicRef(n - 1, x, z, out);
+        out.push_back(Move(PEGS[x], PEGS[y], n));
+        cyclicRef(n - 1, z, y, out);
+    } else {                           // one step back = two forward, via z
+        cyclicRef(n - 1, x, y, out);
+        out.push_back(Move(PEGS[x], PEGS[z], n));
+        cyclicRef(n - 1, y, x, out);
+        out.push_back(Move(PEGS[z], PEGS[y], n));
+        cyclicRef(n - 1, x, y, out);
+    }
+}
+
+static void adjacentRef(int n, int x, int y, std::vector<Move> &out) {   // x, y are the end pegs
+    if (n == 0) return;
+    adjacentRef(n - 1, x, y, out);
+    out.push_back(Move(PEGS[x], PEGS[1], n));
+    adjacentRef(n - 1, y, x, out);
+    out.push_back(Move(PEGS[1], PEGS[y], n));
+    adjacentRef(n - 1, x, y, out);
+}
+
+static void collect(const BenchOptions &opt, std::vector<BenchResult> &out) {
+    auto want = [&](const std::string &name) {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    };
+    Game g;
+
+    for (int n : {8, 12}) {
+        std::vector<Move> moves = optimalMoves(n);
+        std::string name = "Game::moveDisk/n=" + std::to_string(n);
+        if (want(name))
+            out.push_back(runBench(opt, name, moves.size(),
+                [&] { g.init(n); },
+                [&] { for (const Move &m : moves) g.moveDisk(m.from, m.to); }));
+
+        name = "Game::undoMove/n=" + std::to_string(n);
+        if (want(name))
+            out.push_back(runBench(opt, name, moves.size(),
+                [&] { g.init(n); for (const Move &m : moves) g.moveDisk(m.from, m.to); },
+                [&] { for (size_t i = 0; i < moves.size(); i++) g.undoMove(); }));
+    }
+
+    if (want("Game::getTower"))
+        out.push_back(runBench(opt, "Game::getTower", 3000,
+            [&] { g.init(3); },
+            [&] {
+                int acc = 0;
+                for (int i = 0; i < 1000; i++)
+                    for (const char *p : PEGS) acc += g.getTower(p)->size();
+                g_sink = acc;
+            }));
+
+    for (int n : {4, 8, 12, 16}) {
+        std::string name = "Game::generateSolution/n=" + std::to_string(n);
+        if (!want(name)) continue;
+        out.push_back(runBench(opt, name, 1,
+            [&] { g.init(n); },
+            [&] { g.generateSolution(n, "A", "B", "C"); g_sink = (int)g.solutionQueue.size(); }));
+    }
+
+    for (MoveRules rules : {MoveRules::cyclic(), MoveRules::adjacent()}) {
+        const int n = rules == MoveRules::cyclic() ? 10 : 8;
+        VariantSolver solver(rules, n);
+        const uint64_t total = solver.moveCount();
+        const std::string suffix = std::string("/") + rules.name() + "/n=" + std::to_string(n);
+        std::vector<Move> ref;
+        ref.reserve(total);
+
+        std::string name = "variant::recursive" + suffix;
+        if (want(name))
+            out.push_back(runBench(opt, name, total,
+                [&] { ref.clear(); },
+                [&] {
+                    if (rules == MoveRules::cyclic()) cyclicRef(n, 0, 2, ref);
+                    else adjacentRef(n, 0, 2, ref);
+                    g_sink = (int)ref.size();
+                }));
+
+        name = "VariantStream::next" + suffix;
+        if (want(name))
+            out.push_back(runBench(opt, name, total,
+                [&] {},
+                [&] {
+                    VariantStream vs(solver);
+                    int d, f, t, acc = 0;
+                    while (vs.next(d, f, t)) acc += d + f + t;
+                    g_sink = acc;
+                }));
+
+        name = "Game::generateSolution" + suffix;
+        if (want(name))
+            out.push_back(runBench(opt, name, 1,
+                [&] { g.init(n); g.rules = rules; },
+                [&] { g.generateSolution(n, "A", "B", "C"); g_sink = (int)g.solutionQueue.size(); }));
+    }
+    g.rules = MoveRules::classic();
+
+    if (want("adjacentMove/n=8")) {
+        const uint64_t total = VariantSolver(MoveRules::adjacent(), 8).moveCount();
+        out.push_back(runBench(opt, "adjacentMove/n=8", total,
+            [&] {},
+            [&] {
+                int d, f, t, acc = 0;
+                for (uint64_t k = 1; k <= total; k++) { adjacentMove(k, d, f, t); acc += d + f + t; }
+                g_sink = acc;
+            }));
+    }
+
+    // duplicate-size disks: 4 copies of 10 sizes, order kept
+    {
+        const int n = 10, m = 4;
+        const uint64_t total = multiMoveCount(n, m, true);
+        if (want("MultiStream::next/n=10,m=4"))
+            out.push_back(runBench(opt, "MultiStream::next/n=10,m=4", total,
+                [&] {},
+                [&] {
+                    MultiStream ms(n, m, true);
+                    BlockMove b;
+                    int acc = 0;
+                    while (ms.next(b)) acc += b.disk + b.count;
+                    g_sink = acc;
+                }));
+
+        if (want("Game::moveDisk/n=10,m=4")) {
+            std::vector<Move> moves;
+            MultiStream ms(n, m, true);
+            BlockMove b;
+            while (ms.next(b))
+                for (int i = 0; i < b.count; i++) moves.push_back(Move(PEGS[b.from], PEGS[b.to], b.disk));
+            out.push_back(runBench(opt, "Game::moveDisk/n=10,m=4", moves.size(),
+                [&] { g.copies = m; g.keepOrder = true; g.init(n); },
+                [&] { for (const Move &mv : moves) g.moveDisk(mv.from, mv.to); }));
+        }
+        g.copies = 1;
+        g.keepOrder = false;
+    }
+
+    // B games stepped together with the same random actions, once through the
+    // structure-of-arrays BatchEnv and once as a loop over Game objects. One
+    // op is one game stepped once; the pool is single-threaded so both sides
+    // run on one core.
+    {
+        const int n = 8, batch = 1024, steps = 64;
+        std::vector<uint8_t> actions((size_t)batch * steps);
+        uint64_t r = 0x9E3779B97F4A7C15ULL;
+        for (uint8_t &a : actions) { r ^= r << 13; r ^= r >> 7; r ^= r << 17; a = (uint8_t)(r % BatchEnv::NUM_ACTIONS); }
+
+        if (want("BatchEnv::step/n=8,B=1024")) {
+            BatchEnv env(batch, n, 1);
+            out.push_back(runBench(opt, "BatchEnv::step/n=8,B=1024", actions.size(),
+                [&] { env.reset(); },
+                [&] {
+                    for (int s = 0; s < steps; s++) env.step(actions.data() + (size_t)s * batch);
+                    g_sink = (int)env.moves[0];
+                }));
+        }
+
+        if (want("Game::moveDisk loop/n=8,B=1024")) {
+            std::vector<Game> games(batch);
+            out.push_back(runBench(opt, "Game::moveDisk loop/n=8,B=1024", actions.size(),
+                [&] { for (Game &x : games) x.init(n); },
+                [&] {
+                    int acc = 0;
+                    for (int s = 0; s < steps; s++)
+                        for (int i = 0; i < batch; i++) {
+                            uint8_t a = actions[(size_t)s * batch + i];
+                            Game &x = games[i];
+                            acc += x.moveDisk(PEGS[BatchEnv::actionFrom(a)], PEGS[BatchEnv::actionTo(a)]);
+                            if (x.isWon()) x.init(n);
+                        }
+                    g_sink = acc;
+                }));
+        }
+    }
+
+    if (want("Tower::push+top+pop")) {
+        Tower t("A");
+        out.push_back(runBench(opt, "Tower::push+top+pop", 64 * 100,
+            [&] {},
+            [&] {
+                int acc = 0;
+                for (int r = 0; r < 100; r++) {
+                    for (int i = 64; i >= 1; i--) t.push(i);
+                    for (int i = 0; i < 64; i++) { acc += t.top(); t.pop(); }
+                }
+                g_sink = acc;
+            }));
+    }
+
+    for (int n : {3, 8}) {
+        std::string name = "Game::init+reset/n=" + std::to_string(n);
+        if (!want(name)) continue;
+        out.push_back(runBench(opt, name, 200,
+            [&] {},
+            [&] { for (int i = 0; i < 100; i++) { g.init(n); g.reset(n); } }));
+    }
+}
+
+// ─── Checks ───────────────────────────────────────────────────────────────────
+// Fewest moves from the full tower of n sizes × m copies on A to the full
+// tower on C (every run in its starting order with keepOrder), by
+// breadth-first search over every position. A peg is its stack bottom first,
+// one byte per disk: size * 16 + copy label, as Game::init stacks them.
+static uint64_t multiBfsDistance(int n, int m, bool keepOrder) {
+    typedef std::array<std::string, 3> Pos;
+    auto key = [](const Pos &p) { return p[0] + '|' + p[1] + '|' + p[2]; };
+    Pos start;
+    for (int i = n; i >= 1; i--)
+        for (int c = 0; c < m; c++) start[0] += (char)(i * 16 + c);
+    std::unordered_set<std::string> seen{key(start)};
+    std::vector<Pos> level{start}, next;
+    for (uint64_t d = 0; !level.empty(); d++) {
+        next.clear();
+        for (const Pos &p : level) {
+            if (p[2].size() == start[0].size() && (!keepOrder || p[2] == start[0])) return d;
+            for (int f = 0; f < 3; f++) {
+                if (p[f].empty()) continue;
+                char top = p[f].back();
+                for (int t = 0; t < 3; t++) {
+                    if (t == f || (!p[t].empty() && (p[t].back() >> 4) < (top >> 4))) continue;
+                    Pos q = p;
+                    q[f].pop_back();
+                    q[t] += top;
+                    if (seen.insert(key(q)).second) next.push_back(q);
+                }
+            }
+        }
+        level.swap(next);
+    }
+    return ~0ULL;
+}
+
+// Fewest moves from `start` to every position of n single disks under
+// `rules`, by breadth-first search. A position is a base-3 number whose digit
+// k-1 is the peg of disk k; unreachable positions stay at ~0.
+static std::vector<uint64_t> bfsDistances(int n, MoveRules rules, uint32_t start) {
+    uint32_t size = 1;
+    for (int k = 0; k < n; k++) size *= 3;
+    std::vector<uint64_t> dist(size, ~0ULL);
+    std::vector<uint32_t> queue{start};
+    dist[start] = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        uint32_t p = queue[i];
+        int top[3] = {0, 0, 0};
+        uint32_t unit[3] = {0, 0, 0};
+        for (uint32_t k = 1, u = 1; k <= (uint32_t)n; k++, u *= 3)
+            if (!top[p / u % 3]) { top[p / u % 3] = k; unit[p / u % 3] = u; }
+        for (int f = 0; f < 3; f++)
+            for (int t = 0; t < 3; t++) {
+                if (t == f || !top[f] || (top[t] && top[t] < top[f]) || !rules.allows(f, t)) continue;
+                uint32_t q = p - f * unit[f] + t * unit[f];
+                if (dist[q] == ~0ULL) { dist[q] = dist[p] + 1; queue.push_back(q); }
+            }
+    }
+    return dist;
+}
+
+static uint32_t towerCode(int n, int peg) {
+    uint32_t c = 0;
+    for (int k = 0; k < n; k++) c = c * 3 + peg;
+    return c;
+}
+
+// positionDistance() between every pair of positions, and distanceToPeg()
+// from every position to each tower, must equal the BFS optimum under the
+// classic rules for up to 6 disks.
+static int checkPositionDistance() {
+    int failures = 0;
+    for (int n = 1; n <= 6; n++) {
+        uint32_t size = 1;
+        for (int k = 0; k < n; k++) size *= 3;
+        auto pegs = [n](uint32_t code, uint64_t p[3]) {
+            p[0] = p[1] = p[2] = 0;
+            for (int k = 0; k < n; k++, code /= 3) p[code % 3] |= 1ULL << k;
+        };
+        int bad = 0;
+        for (uint32_t a = 0; a < size; a++) {
+            std::vector<uint64_t> dist = bfsDistances(n, MoveRules::classic(), a);
+            uint64_t s[3], t[3];
+            pegs(a, s);
+            for (int peg = 0; peg < 3; peg++) {
+                uint64_t d = distanceToPeg(s[0], s[1], n, peg), want = dist[towerCode(n, peg)];
+                if (d != want && bad++ < 10)
+                    printf("distanceToPeg n=%d %u -> tower %c: %llu, bfs %llu  MISMATCH\n",
+                           n, a, 'A' + peg, (unsigned long long)d, (unsigned long long)want);
+            }
+            for (uint32_t b = 0; b < size; b++) {
+                pegs(b, t);
+                uint64_t d = positionDistance(s, t, n);
+                if (d != dist[b] && bad++ < 10)
+                    printf("positionDistance n=%d %u -> %u: %llu, bfs %llu  MISMATCH\n",
+                           n, a, b, (unsigned long long)d, (unsigned long long)dist[b]);
+            }
+        }
+        failures += bad;
+        printf("positionDistance n=%d: %u x %u positions  %s\n", n, size, size, bad ? "MISMATCH" : "ok");
+    }
+    return failures;
+}
+
+// Every rule set (each subset of the six peg-to-peg moves) for up to 6 disks:
+// VariantSolver::moveCount must equal the BFS optimum between every pair of
+// towers, and VariantStream must replay legally to the target in exactly that
+// many moves. The cyclic and adjacent streams must then match the reference
+// recursions move for move, and adjacentMove() the adjacent stream.
+static int checkVariants() {
+    static const int edges[6][2] = {{0, 1}, {0, 2}, {1, 0}, {1, 2}, {2, 0}, {2, 1}};
+    int failures = 0;
+    for (int n = 1; n <= 6; n++) {
+        int bad = 0, solvable = 0;
+        for (int set = 0; set < 64; set++) {
+            MoveRules rules{0};
+            for (int e = 0; e < 6; e++)
+                if (set >> e & 1) rules.mask |= (uint16_t)(1 << (edges[e][0] * 3 + edges[e][1]));
+            VariantSolver solver(rules, n);
+            for (int x = 0; x < 3; x++) {
+                std::vector<uint64_t> dist = bfsDistances(n, rules, towerCode(n, x));
+                for (int y = 0; y < 3; y++) {
+                    if (y == x) continue;
+                    uint64_t bfs = dist[towerCode(n, y)], count = solver.moveCount(x, y);
+                    VariantStream vs(solver, x, y);
+                    uint32_t pos = towerCode(n, x), u[7] = {0, 1};
+                    for (int k = 2; k <= n; k++) u[k] = u[k - 1] * 3;
+                    uint64_t streamed = 0;
+                    bool legal = true;
+                    int d, f, t;
+                    while (legal && vs.next(d, f, t)) {
+                        streamed++;
+                        bool onTop = d >= 1 && d <= n && (int)(pos / u[d] % 3) == f;
+                        for (int k = 1; onTop && k < d; k++) onTop = (int)(pos / u[k] % 3) != f && (int)(pos / u[k] % 3) != t;
+                        legal = onTop && rules.allows(f, t);
+                        pos = pos - f * u[d] + t * u[d];
+                    }
+                    bool ok = count == VariantSolver::UNSOLVABLE
+                        ? bfs == ~0ULL && streamed == 0
+                        : bfs == count && streamed == count && legal && pos == towerCode(n, y);
+                    solvable += count != VariantSolver::UNSOLVABLE;
+                    if (!ok) {
+                        bad++;
+                        printf("variant n=%d rules %03x %c->%c: bfs %llu  solver %llu  stream %llu%s  MISMATCH\n",
+                               n, rules.mask, 'A' + x, 'A' + y, (unsigned long long)bfs,
+                               (unsigned long long)count, (unsigned long long)streamed,
+                               legal ? "" : " (illegal move)");
+                    }
+                }
+            }
+        }
+        failures += bad;
+        printf("variant n=%d: 64 rule sets x 6 tower pairs, %d solvable  %s\n",
+               n, solvable, bad ? "MISMATCH" : "ok");
+    }
+
+    auto same = [](const std::vector<Move> &ref, VariantStream vs) {
+        size_t i = 0;
+        int d, f, t;
+        for (; vs.next(d, f, t); i++)
+            if (i >= ref.size() || ref[i].diskSize != d || ref[i].from != PEGS[f] || ref[i].to != PEGS[t])
+                return false;
+        return i == ref.size();
+    };
+    for (int n = 1; n <= 10; n++) {
+        bool ok = true;
+        VariantSolver cyclic(MoveRules::cyclic(), n), adjacent(MoveRules::adjacent(), n);
+        for (int x = 0; x < 3; x++)
+            for (int y = 0; y < 3; y++) {
+                if (y == x) continue;
+                std::vector<Move> ref;
+                cyclicRef(n, x, y, ref);
+                ok = ok && same(ref, VariantStream(cyclic, x, y));
+            }
+        std::vector<Move> ref;
+        adjacentRef(n, 2, 0, ref);
+        ok = ok && same(ref, VariantStream(adjacent, 2, 0));
+        ref.clear();
+        adjacentRef(n, 0, 2, ref);
+        ok = ok && same(ref, VariantStream(adjacent, 0, 2));
+        for (uint64_t k = 1; ok && k <= ref.size(); k++) {
+            int d, f, t;
+            adjacentMove(k, d, f, t);
+            const Move &m = ref[k - 1];
+            ok = m.diskSize == d && m.from == PEGS[f] && m.to == PEGS[t];
+        }
+        failures += !ok;
+        printf("variant n=%d: cyclic and adjacent streams, adjacentMove vs recursion  %s\n",
+               n, ok ? "ok" : "MISMATCH");
+    }
+    return failures;
+}
+
+// For every case small enough to search: the BFS optimum, multiMoveCount()
+// and the length of Game::generateSolution's queue (MultiStream) must agree,
+// and replaying the queue through Game::moveDisk must win the game.
+static int runChecks() {
+    static const int cases[][2] = {{1, 1}, {1, 2}, {1, 3}, {1, 4}, {2, 1}, {2, 2}, {2, 3}, {2, 4},
+                                   {3, 1}, {3, 2}, {3, 3}, {4, 1}, {4, 2}, {5, 2}};
+    int failures = 0;
+    Game g;
+    for (const auto &c : cases)
+        for (bool keepOrder : {false, true}) {
+            const int n = c[0], m = c[1];
+            uint64_t bfs = multiBfsDistance(n, m, keepOrder);
+            uint64_t formula = multiMoveCount(n, m, keepOrder);
+            g.copies = m;
+            g.keepOrder = keepOrder;
+            g.init(n);
+            g.generateSolution(n, "A", "B", "C");
+            uint64_t queued = g.solutionQueue.size();
+            bool legal = true;
+            for (; !g.solutionQueue.empty(); g.solutionQueue.pop())
+                legal = legal && g.moveDisk(g.solutionQueue.front().from, g.solutionQueue.front().to);
+            bool ok = bfs == formula && queued == formula && legal && g.isWon();
+            failures += !ok;
+            printf("multidisk n=%d m=%d %-9s bfs %4llu  formula %4llu  solution %4llu%s  %s\n",
+                   n, m, keepOrder ? "ordered" : "unordered", (unsigned long long)bfs,
+                   (unsigned long long)formula, (unsigned long long)queued,
+                   legal && g.isWon() ? "" : " (does not solve)", ok ? "ok" : "MISMATCH");
+        }
+    g.copies = 1;
+    g.keepOrder = false;
+    failures += checkPositionDistance();
+    failures += checkVariants();
+    if (failures) printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
+
+// ─── Reporting ────────────────────────────────────────────────────────────────
+static bool writeJson(const char *path, const std::vector<BenchResult> &rs) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\"benchmarks\":[\n");
+    for (size_t i = 0; i < rs.size(); i++) {
+        const BenchResult &r = rs[i];
+        fprintf(f, "{\"name\":\"%s\",\"ops_per_sample\":%llu,\"median_ns\":%.3f,"
+                   "\"p99_ns\":%.3f,\"min_ns\":%.3f,\"allocs_per_op\":%.4f}%s\n",
+                r.name.c_str(), (unsigned long long)r.opsPerSample, r.medianNs, r.p99Ns,
+                r.minNs, r.allocsPerOp, i + 1 < rs.size() ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    return fclose(f) == 0;
+}
+
+// reads back what writeJson produces: one benchmark object per line
+static std::map<std::string, double> readBaseline(const char *path) {
+    std::map<std::string, double> m;
+    FILE *f = fopen(path, "r");
+    if (!f) return m;
+    char line[1024];
+    while (fgets(line, sizeof line, f)) {
+        const char *n = strstr(line, "\"name\":\"");
+        const char *med = strstr(line, "\"median_ns\":");
+        if (!n || !med) continue;
+        n += 8;
+        const char *e = strchr(n, '"');
+        if (!e) continue;
+        m[std::string(n, e)] = atof(med + 12);
+    }
+    fclose(f);
+    return m;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hanoi_bench [--samples N] [--filter text] [--json out.json]\n"
+                    "                   [--baseline base.json] [--threshold 0.10]\n"
+                    "       hanoi_bench --check\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions opt;
+    const char *jsonPath = nullptr, *basePath = nullptr;
+    double threshold = 0.10;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--samples")   opt.samples = std::max(1, atoi(val()));
+        else if (a == "--filter")    opt.filter = val();
+        else if (a == "--json")      jsonPath = val();
+        else if (a == "--baseline")  basePath = val();
+        else if (a == "--threshold") threshold = atof(val());
+        else if (a == "--check")     return runChecks();
+        else usage();
+    }
+
+    std::vector<BenchResult> rs;
+    collect(opt, rs);
+
+    std::map<std::string, double> base;
+    if (basePath) {
+        base = readBaseline(basePath);
+        if (base.empty()) fprintf(stderr, "hanoi_bench: no baseline data in %s\n", basePath);
+    }
+
+    int regressions = 0;
+    printf("%-32s %12s %12s %12s %10s %s\n", "benchmark", "median ns", "p99 ns", "min ns",
+           "allocs/op", basePath ? "vs baseline" : "");
+    for (const BenchResult &r : rs) {
+        printf("%-32s %12.2f %12.2f %12.2f %10.3f", r.name.c_str(), r.medianNs, r.p99Ns,
+               r.minNs, r.allocsPerOp);
+        auto it = base.find(r.name);
+        if (it != base.end() && it->second > 0) {
+            double delta = r.medianNs / it->second - 1.0;
+            bool bad = delta > threshold;
+            regressions += bad;
+            printf(" %+7.1f%%%s", delta * 100, bad ? "  REGRESSION" : "");
+        }
+        printf("\n");
+    }
+
+    if (jsonPath && !writeJson(jsonPath, rs)) {
+        perror(jsonPath);
+        return 2;
+    }
+    if (regressions) {
+        printf("%d benchmark(s) regressed by more than %.0f%%\n", regressions, threshold * 100);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,622 @@
+// Local solver daemon: a long-running headless service that answers batched
+// solver queries over a Unix stream socket, so tools stop paying process
+// start-up per question. Linux only (epoll, eventfd, signalfd).
+//
+//   hanoi_daemon [--socket path] [--threads T] [--warm n]
+//
+// Protocol and client: solverproto.h. Every query is a closed form from
+// solver.h (k-th move, position after k moves, distances, next optimal
+// move) except move ranges, which are sliced out of packed solution tables
+// (HNMV nibbles) for up to TABLE_MAX_DISKS disks, built once per n on first
+// use and kept for the daemon's lifetime; --warm builds the tables up to n at
+// start-up (default 20, 1 MB). Larger n fall back to optimalMove per move.
+//
+// One thread runs the epoll loop: it accepts, reads, parses and answers
+// batches in place. A batch asking for more than INLINE_RANGE range moves
+// goes to the worker threads instead; its reply slot waits in the
+// connection's queue, so replies still leave in request order, and the
+// worker hands the bytes back through an eventfd. A connection with more
+// than OUT_HIGH bytes of replies queued, counting the expected size of the
+// batches still on the workers, is neither read nor parsed until it drains.
+// SIGINT / SIGTERM stop the loop, remove the socket and print totals.
+
+#include "movefile.h"
+#include "solver.h"
+#include "solverproto.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/stat.h>
+
+static const int      TABLE_MAX_DISKS = 24;        // largest table: 2^24 moves in 8 MB
+static const uint64_t INLINE_RANGE    = 1 << 16;   // range moves a batch may ask for on the loop thread
+static const size_t   READ_CHUNK      = 64 << 10;
+static const size_t   OUT_HIGH        = 64 << 20;  // queued reply bytes before a connection is paused
+static const int      MAX_EVENTS      = 64;
+
+// epoll tags below the first connection id
+enum : uint64_t { TAG_LISTEN = 1, TAG_WAKE, TAG_SIGNAL, FIRST_CONN = 16 };
+
+// ─── Solution tables ───
+
+class SolutionTables {
+public:
+    // packed solution for n disks, or nullptr above TABLE_MAX_DISKS
+    const std::vector<uint8_t> *get(int n) {
+        if (n < 1 || n > TABLE_MAX_DISKS) return nullptr;
+        std::vector<uint8_t> &t = tables[n];
+        std::call_once(once[n], [this, n, &t] { build(n, t); });
+        return &t;
+    }
+
+    size_t bytes() {
+        std::lock_guard<std::mutex> lk(m);
+        return total;
+    }
+
+private:
+    std::once_flag once[TABLE_MAX_DISKS + 1];
+    std::vector<uint8_t> tables[TABLE_MAX_DISKS + 1];
+    std::mutex m;
+    size_t total = 0;
+
+    void build(int n, std::vector<uint8_t> &t) {
+        const uint64_t moves = optimalMoveCount(n);
+        t.assign((size_t)(moves + 1) / 2, 0);
+        int disk, from, to;
+        for (uint64_t k = 1; k <= moves; k++) {
+            optimalMove(n, k, disk, from, to);
+            t[(k - 1) >> 1] |= (uint8_t)(packMove(from, to) << ((k - 1) & 1 ? 4 : 0));
+        }
+        std::lock_guard<std::mutex> lk(m);
+        total += t.size();
+    }
+};
+
+static SolutionTables tables;
+
+// moves first .. first+count-1 of the n-disk solution as HNMV nibbles
+static void fillRange(int n, uint64_t first, uint64_t count, uint8_t *out) {
+    const size_t bytes = (size_t)(count + 1) / 2;
+    if (const std::vector<uint8_t> *t = tables.get(n)) {
+        const size_t at = (size_t)((first - 1) >> 1), avail = t->size() - at;
+        const uint8_t *src = t->data() + at;
+        if (((first - 1) & 1) == 0) {
+            memcpy(out, src, bytes);
+        } else {   // starts on a high nibble: shift everything down by one
+            for (size_t i = 0; i < bytes; i++)
+                out[i] = (uint8_t)(src[i] >> 4 | (i + 1 < avail ? src[i + 1] << 4 : 0));
+        }
+        if (count & 1) out[bytes - 1] &= 0x0F;
+        return;
+    }
+    memset(out, 0, bytes);
+    int disk, from, to;
+    for (uint64_t i = 0; i < count; i++) {
+        optimalMove(n, first + i, disk, from, to);
+        out[i >> 1] |= (uint8_t)(packMove(from, to) << (i & 1 ? 4 : 0));
+    }
+}
+
+// ─── Queries ───
+
+static bool validPosition(uint64_t a, uint64_t b, int n) {
+    uint64_t all = fullTowerMask(n);
+    return (a & b) == 0 && ((a | b) & ~all) == 0;
+}
+
+// moves a range query will return, 0 if it is invalid
+static uint64_t rangeLength(const SolverQuery &q) {
+    if (q.op != SOLVER_MOVE_RANGE || q.n < 1 || q.n > SOLVER_MAX_DISKS) return 0;
+    uint64_t total = optimalMoveCount(q.n);
+    if (q.arg[0] < 1 || q.arg[0] > total || q.arg[1] == 0) return 0;
+    return std::min(q.arg[1], total - q.arg[0] + 1);
+}
+
+// everything but range payloads
+static void answer(const SolverQuery &q, SolverResult &r) {
+    memset(&r, 0, sizeof(r));
+    r.status = SOLVER_BAD_ARGS;
+    const int n = q.n;
+    if (n < 1 || n > SOLVER_MAX_DISKS) return;
+    int disk, from, to;
+    switch (q.op) {
+    case SOLVER_MOVE_AT:
+        if (q.arg[0] < 1 || q.arg[0] > optimalMoveCount(n)) return;
+        optimalMove(n, q.arg[0], disk, from, to);
+        r.disk = (uint8_t)disk; r.from = (uint8_t)from; r.to = (uint8_t)to;
+        break;
+    case SOLVER_STATE_AT:
+        if (q.arg[0] > optimalMoveCount(n)) return;
+        optimalState(n, q.arg[0], r.value);
+        break;
+    case SOLVER_DISTANCE: {
+        if (!validPosition(q.arg[0], q.arg[1], n) || !validPosition(q.arg[2], q.arg[3], n)) return;
+        uint64_t all = fullTowerMask(n);
+        const uint64_t s[3] = {q.arg[0], q.arg[1], all & ~(q.arg[0] | q.arg[1])};
+        const uint64_t t[3] = {q.arg[2], q.arg[3], all & ~(q.arg[2] | q.arg[3])};
+        r.value[0] = positionDistance(s, t, n);
+        break;
+    }
+    case SOLVER_TOWER_DISTANCE:
+        if (!validPosition(q.arg[0], q.arg[1], n) || q.target > 2) return;
+        r.value[0] = distanceToPeg(q.arg[0], q.arg[1], n, q.target);
+        break;
+    case SOLVER_NEXT_MOVE:
+        if (!validPosition(q.arg[0], q.arg[1], n) || q.target > 2) return;
+        if (!nextOptimalMove(q.arg[0], q.arg[1], n, q.target, disk, from, to)) {
+            r.status = SOLVER_SOLVED;
+            return;
+        }
+        r.disk = (uint8_t)disk; r.from = (uint8_t)from; r.to = (uint8_t)to;
+        r.value[0] = distanceToPeg(q.arg[0], q.arg[1], n, q.target);
+        break;
+    case SOLVER_MOVE_RANGE:
+        r.value[0] = rangeLength(q);
+        if (r.value[0] == 0) return;
+        if (r.value[0] > SOLVER_MAX_RANGE) { r.status = SOLVER_TOO_LARGE; return; }
+        r.payload = (uint32_t)((r.value[0] + 1) / 2);
+        break;
+    default:
+        r.status = SOLVER_BAD_OP;
+        return;
+    }
+    r.status = SOLVER_OK;
+}
+
+// complete reply frame for one batch
+static std::vector<char> answerBatch(uint32_t batch, const SolverQuery *q, uint32_t count) {
+    std::vector<SolverResult> res(count);
+    uint64_t payload = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        answer(q[i], res[i]);
+        if (res[i].payload == 0) continue;
+        if (payload + res[i].payload > SOLVER_MAX_PAYLOAD) {
+            res[i].status = SOLVER_TOO_LARGE;
+            res[i].payload = 0;
+            continue;
+        }
+        payload += res[i].payload;
+    }
+
+    SolverReplyHeader h;
+    memcpy(h.magic, SOLVER_REPLY_MAGIC, 4);
+    h.batch = batch;
+    h.count = count;
+    h.payload = (uint32_t)payload;
+    std::vector<char> out(sizeof(h) + (size_t)count * sizeof(SolverResult) + payload);
+    memcpy(out.data(), &h, sizeof(h));
+    memcpy(out.data() + sizeof(h), res.data(), (size_t)count * sizeof(SolverResult));
+    uint8_t *p = (uint8_t *)out.data() + sizeof(h) + (size_t)count * sizeof(SolverResult);
+    for (uint32_t i = 0; i < count; i++) {
+        if (res[i].payload == 0) continue;
+        fillRange(q[i].n, q[i].arg[0], res[i].value[0], p);
+        p += res[i].payload;
+    }
+    return out;
+}
+
+// size answerBatch() will make the reply, counted against OUT_HIGH while a
+// worker builds it
+static size_t replySize(const SolverQuery *q, uint32_t count) {
+    uint64_t payload = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t len = rangeLength(q[i]);
+        if (len == 0 || len > SOLVER_MAX_RANGE) continue;
+        if (payload + (len + 1) / 2 <= SOLVER_MAX_PAYLOAD) payload += (len + 1) / 2;
+    }
+    return sizeof(SolverReplyHeader) + (size_t)count * sizeof(SolverResult) + (size_t)payload;
+}
+
+// ─── Workers ───
+
+// Reply produced off the loop thread for connection `conn`'s batch `seq`.
+struct Done {
+    uint64_t conn, seq;
+    std::vector<char> data;
+};
+
+class Workers {
+public:
+    Workers(int threads, int wakeFd) : wake(wakeFd), stopping(false) {
+        for (int i = 0; i < threads; i++) pool.emplace_back([this] { loop(); });
+    }
+
+    ~Workers() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &t : pool) t.join();
+    }
+
+    void submit(uint64_t conn, uint64_t seq, uint32_t batch, std::vector<SolverQuery> q) {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            jobs.push_back(Job{conn, seq, batch, std::move(q)});
+        }
+        cv.notify_one();
+    }
+
+    // replies finished since the last call
+    void collect(std::vector<Done> &out) {
+        std::lock_guard<std::mutex> lk(m);
+        for (Done &d : done) out.push_back(std::move(d));
+        done.clear();
+    }
+
+    int size() const { return (int)pool.size(); }
+
+private:
+    struct Job {
+        uint64_t conn, seq;
+        uint32_t batch;
+        std::vector<SolverQuery> q;
+    };
+
+    int wake;
+    std::vector<std::thread> pool;
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<Job> jobs;
+    std::vector<Done> done;
+    bool stopping;
+
+    void loop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            std::vector<char> data = answerBatch(job.batch, job.q.data(), (uint32_t)job.q.size());
+            {
+                std::lock_guard<std::mutex> lk(m);
+                done.push_back(Done{job.conn, job.seq, std::move(data)});
+            }
+            uint64_t one = 1;
+            if (write(wake, &one, sizeof(one)) < 0) perror("hanoi_daemon: eventfd");
+        }
+    }
+};
+
+// ─── Connections ───
+
+struct Reply {
+    bool ready;
+    std::vector<char> data;
+    size_t expected;   // bytes counted in Conn::queued before the data is ready
+};
+
+struct Conn {
+    int fd;
+    std::vector<char> in;        // unparsed request bytes
+    std::deque<Reply> replies;   // in request order; only a ready prefix is sent
+    uint64_t firstSeq = 0;       // sequence number of replies.front()
+    size_t sent = 0;             // bytes of replies.front() already written
+    size_t queued = 0;           // reply bytes not yet written, pending ones as expected
+    uint32_t events = 0;         // current epoll interest
+    bool eof = false;            // peer shut down its side: answer what came, then close
+    bool broken = false;         // peer gone or protocol error: close now
+};
+
+struct Stats {
+    uint64_t connections = 0, batches = 0, queries = 0, offloaded = 0, rangeMoves = 0;
+};
+
+class Server {
+public:
+    Server(int epollFd, Workers &w) : ep(epollFd), workers(w), nextId(FIRST_CONN) {}
+
+    ~Server() {
+        for (auto &c : conns) close(c.second.fd);
+    }
+
+    void accept(int listenFd) {
+        for (;;) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) perror("hanoi_daemon: accept");
+                return;
+            }
+            uint64_t id = nextId++;
+            Conn &c = conns[id];
+            c.fd = fd;
+            stats.connections++;
+            watch(id, c);
+        }
+    }
+
+    void event(uint64_t id, uint32_t ev) {
+        auto it = conns.find(id);
+        if (it == conns.end()) return;
+        Conn &c = it->second;
+        if (ev & (EPOLLHUP | EPOLLERR)) c.broken = true;
+        else if (ev & EPOLLIN) readFrom(id, c);
+        if (!c.broken && (ev & EPOLLOUT)) flush(c);
+        settle(id, c);
+    }
+
+    void completed(std::vector<Done> &done) {
+        for (Done &d : done) {
+            auto it = conns.find(d.conn);
+            if (it == conns.end()) continue;   // client left meanwhile
+            Conn &c = it->second;
+            Reply &r = c.replies[d.seq - c.firstSeq];
+            r.data = std::move(d.data);
+            r.ready = true;
+            c.queued = c.queued - r.expected + r.data.size();
+            flush(c);
+            settle(d.conn, c);
+        }
+        done.clear();
+    }
+
+    const Stats &totals() const { return stats; }
+
+private:
+    int ep;
+    Workers &workers;
+    uint64_t nextId;
+    std::unordered_map<uint64_t, Conn> conns;
+    Stats stats;
+
+    void readFrom(uint64_t id, Conn &c) {
+        while (c.queued < OUT_HIGH) {
+            size_t old = c.in.size();
+            c.in.resize(old + READ_CHUNK);
+            ssize_t r = read(c.fd, c.in.data() + old, READ_CHUNK);
+            c.in.resize(old + (r > 0 ? (size_t)r : 0));
+            if (r == 0) { c.eof = true; break; }
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) c.broken = true;
+                break;
+            }
+            if (!parse(id, c)) { c.broken = true; break; }
+        }
+        flush(c);
+    }
+
+    // answers complete batches in c.in until OUT_HIGH bytes are queued; the
+    // rest waits for the replies to drain. False on a malformed frame.
+    bool parse(uint64_t id, Conn &c) {
+        size_t pos = 0;
+        while (c.queued < OUT_HIGH && c.in.size() - pos >= sizeof(SolverRequestHeader)) {
+            SolverRequestHeader h;
+            memcpy(&h, c.in.data() + pos, sizeof(h));
+            if (memcmp(h.magic, SOLVER_REQUEST_MAGIC, 4) != 0 || h.count == 0 || h.count > SOLVER_MAX_BATCH)
+                return false;
+            size_t need = sizeof(h) + (size_t)h.count * sizeof(SolverQuery);
+            if (c.in.size() - pos < need) break;
+
+            std::vector<SolverQuery> q(h.count);
+            memcpy(q.data(), c.in.data() + pos + sizeof(h), (size_t)h.count * sizeof(SolverQuery));
+            pos += need;
+            uint64_t range = 0;
+            for (const SolverQuery &x : q) range += rangeLength(x);
+            stats.batches++;
+            stats.queries += h.count;
+            stats.rangeMoves += range;
+
+            const uint64_t seq = c.firstSeq + c.replies.size();
+            if (range > INLINE_RANGE) {
+                c.replies.push_back(Reply{false, {}, replySize(q.data(), h.count)});
+                c.queued += c.replies.back().expected;
+                workers.submit(id, seq, h.batch, std::move(q));
+                stats.offloaded++;
+            } else {
+                c.replies.push_back(Reply{true, answerBatch(h.batch, q.data(), h.count), 0});
+                c.queued += c.replies.back().data.size();
+            }
+        }
+        c.in.erase(c.in.begin(), c.in.begin() + (ptrdiff_t)pos);
+        return true;
+    }
+
+    // writes the ready prefix of the reply queue until the socket is full
+    void flush(Conn &c) {
+        while (!c.replies.empty() && c.replies.front().ready) {
+            const std::vector<char> &d = c.replies.front().data;
+            while (c.sent < d.size()) {
+                ssize_t w = send(c.fd, d.data() + c.sent, d.size() - c.sent, MSG_NOSIGNAL);
+                if (w < 0 && errno == EINTR) continue;
+                if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+                if (w <= 0) { c.broken = true; return; }
+                c.sent += (size_t)w;
+                c.queued -= (size_t)w;
+            }
+            c.replies.pop_front();
+            c.firstSeq++;
+            c.sent = 0;
+        }
+    }
+
+    // closes a finished connection, else matches epoll interest to its state
+    void settle(uint64_t id, Conn &c) {
+        // batches parse() left behind once the queue has drained
+        if (!c.broken && c.queued < OUT_HIGH && c.in.size() >= sizeof(SolverRequestHeader)) {
+            if (parse(id, c)) flush(c);
+            else c.broken = true;
+        }
+        if (c.broken || (c.eof && c.replies.empty())) {
+            drop(id, c);
+            return;
+        }
+        uint32_t want = 0;
+        if (!c.eof && c.queued < OUT_HIGH) want |= EPOLLIN;
+        if (!c.replies.empty() && c.replies.front().ready) want |= EPOLLOUT;
+        if (want != c.events) {
+            epoll_event e;
+            e.events = want;
+            e.data.u64 = id;
+            epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &e);
+            c.events = want;
+        }
+    }
+
+    void watch(uint64_t id, Conn &c) {
+        epoll_event e;
+        e.events = c.events = EPOLLIN;
+        e.data.u64 = id;
+        if (epoll_ctl(ep, EPOLL_CTL_ADD, c.fd, &e) != 0) {
+            perror("hanoi_daemon: epoll_ctl");
+            drop(id, c);
+        }
+    }
+
+    void drop(uint64_t id, Conn &c) {
+        epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+        close(c.fd);
+        conns.erase(id);
+    }
+};
+
+// ─── Socket ───
+
+// refuses to replace a live daemon's socket; removes a stale one
+static int listenOn(const std::string &path) {
+    sockaddr_un addr;
+    if (!makeSolverAddress(path, addr)) {
+        fprintf(stderr, "hanoi_daemon: socket path too long: %s\n", path.c_str());
+        return -1;
+    }
+    SolverClient probe;
+    if (probe.connect(path)) {
+        fprintf(stderr, "hanoi_daemon: a daemon is already listening on %s\n", path.c_str());
+        return -1;
+    }
+    unlink(path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) { perror("hanoi_daemon: socket"); return -1; }
+    mode_t old = umask(0077);   // owner only
+    int rc = bind(fd, (const sockaddr *)&addr, sizeof(addr));
+    umask(old);
+    if (rc != 0 || listen(fd, SOMAXCONN) != 0) {
+        perror(path.c_str());
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hanoi_daemon [--socket path] [--threads T] [--warm n]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    std::string path = defaultSolverSocket();
+    int threads = 0, warm = 20;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--socket")  path = val();
+        else if (a == "--threads") threads = atoi(val());
+        else if (a == "--warm")    warm = atoi(val());
+        else usage();
+    }
+    if (threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    if (warm < 0 || warm > TABLE_MAX_DISKS) {
+        fprintf(stderr, "hanoi_daemon: --warm must be 0..%d\n", TABLE_MAX_DISKS);
+        return 2;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int n = 1; n <= warm; n++) tables.get(n);
+    double warmSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // SIGINT / SIGTERM arrive through the loop instead of interrupting it
+    sigset_t sigs;
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGTERM);
+    sigprocmask(SIG_BLOCK, &sigs, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    int lfd = listenOn(path);
+    if (lfd < 0) return 1;
+    int sfd = signalfd(-1, &sigs, SFD_NONBLOCK | SFD_CLOEXEC);
+    int wfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    if (sfd < 0 || wfd < 0 || ep < 0) {
+        perror("hanoi_daemon");
+        unlink(path.c_str());
+        return 1;
+    }
+    const int fds[3] = {lfd, wfd, sfd};
+    const uint64_t tags[3] = {TAG_LISTEN, TAG_WAKE, TAG_SIGNAL};
+    for (int i = 0; i < 3; i++) {
+        epoll_event e;
+        e.events = EPOLLIN;
+        e.data.u64 = tags[i];
+        epoll_ctl(ep, EPOLL_CTL_ADD, fds[i], &e);
+    }
+
+    fprintf(stderr, "hanoi_daemon: listening on %s, %d workers, tables 1..%d warm (%.1f MB, %.2f s)\n",
+            path.c_str(), threads, warm, tables.bytes() / 1048576.0, warmSecs);
+
+    auto started = std::chrono::steady_clock::now();
+    Stats totals;
+    {
+        Workers workers(threads, wfd);
+        Server server(ep, workers);
+        std::vector<Done> done;
+        epoll_event events[MAX_EVENTS];
+        bool running = true;
+        while (running) {
+            int got = epoll_wait(ep, events, MAX_EVENTS, -1);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                perror("hanoi_daemon: epoll_wait");
+                break;
+            }
+            for (int i = 0; i < got; i++) {
+                uint64_t tag = events[i].data.u64;
+                if (tag == TAG_LISTEN) {
+                    server.accept(lfd);
+                } else if (tag == TAG_WAKE) {
+                    uint64_t n;
+                    while (read(wfd, &n, sizeof(n)) > 0) {}
+                    workers.collect(done);
+                    server.completed(done);
+                } else if (tag == TAG_SIGNAL) {
+                    running = false;
+                } else {
+                    server.event(tag, events[i].events);
+                }
+            }
+        }
+        totals = server.totals();
+    }
+
+    close(lfd);
+    unlink(path.c_str());
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    fprintf(stderr, "hanoi_daemon: %llu connections, %llu batches (%llu on workers), %llu queries, "
+            "%llu range moves in %.1f s\n",
+            (unsigned long long)totals.connections, (unsigned long long)totals.batches,
+            (unsigned long long)totals.offloaded, (unsigned long long)totals.queries,
+            (unsigned long long)totals.rangeMoves, secs);
+    return 0;
+}
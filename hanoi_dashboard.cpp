@@ -0,0 +1,110 @@
+// Multi-board dashboard for kiosks and demo walls.
+//
+//   hanoi_dashboard [--boards N] [--disks MIN[-MAX]] [--speed MOVES_PER_SEC]
+//                   [--replay moves.hnmv] [--fullscreen] [--frames N]
+//
+// Shows N independent games in a grid, each auto-solving at its own pace
+// and starting over once solved. With --replay every other board plays the
+// packed HNMV move file (movefile.h) instead; a board whose replay breaks
+// the rules stops and is framed in red. All boards share one ticker and one
+// paint pass (see dashboard.h). F3 shows frame and paint times, F11 toggles
+// full screen.
+//
+// --frames N quits after N frames and prints frame-interval and paint-time
+// percentiles, e.g. QT_QPA_PLATFORM=offscreen hanoi_dashboard --frames 600.
+
+#include "dashboard.h"
+#include "movefile.h"
+#include <QApplication>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static void usage() {
+    fprintf(stderr, "usage: hanoi_dashboard [--boards N] [--disks MIN[-MAX]] [--speed MOVES_PER_SEC]\n"
+                    "                       [--replay moves.hnmv] [--fullscreen] [--frames N]\n");
+    exit(2);
+}
+
+// Unpacks an HNMV file to one move per byte; returns the disk count or 0.
+static int loadReplay(const char *path, std::vector<uint8_t> &moves) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return 0; }
+    MoveFileHeader h;
+    if (fread(&h, 1, sizeof h, f) != sizeof h || !isMoveFileHeader(&h, sizeof h) ||
+        h.version != MOVEFILE_VERSION) {
+        fprintf(stderr, "hanoi_dashboard: %s is not an HNMV move file\n", path);
+        fclose(f);
+        return 0;
+    }
+    if (h.numDisks < 1 || h.numDisks > Dashboard::MAX_DISKS) {
+        fprintf(stderr, "hanoi_dashboard: %s has %d disks, at most %d fit a tile\n", path,
+                h.numDisks, Dashboard::MAX_DISKS);
+        fclose(f);
+        return 0;
+    }
+    // the header's count is only a claim: size the buffer from the file
+    long body = ftell(f);
+    long end = fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+    if (body < 0 || end < body || fseek(f, body, SEEK_SET) != 0 ||
+        h.moveCount > (uint64_t)(end - body) * 2) {
+        fprintf(stderr, "hanoi_dashboard: %s is truncated (header says %llu moves)\n", path,
+                (unsigned long long)h.moveCount);
+        fclose(f);
+        return 0;
+    }
+    std::vector<uint8_t> packed((size_t)((h.moveCount + 1) / 2));
+    size_t got = fread(packed.data(), 1, packed.size(), f);
+    fclose(f);
+    moves.clear();
+    moves.reserve(h.moveCount);
+    for (uint64_t k = 0; k < h.moveCount && k / 2 < got; k++)
+        moves.push_back(k & 1 ? packed[k / 2] >> 4 : packed[k / 2] & 15);
+    return h.numDisks;
+}
+
+int main(int argc, char *argv[]) {
+    Dashboard::Options opt;
+    const char *replayPath = nullptr;
+    bool fullscreen = false;
+    long frames = 0;
+    for (int i = 1; i < argc; i++) {
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if (!strcmp(argv[i], "--boards")) opt.boards = atoi(val());
+        else if (!strcmp(argv[i], "--disks")) {
+            const char *v = val();
+            const char *dash = strchr(v, '-');
+            opt.minDisks = atoi(v);
+            opt.maxDisks = dash ? atoi(dash + 1) : opt.minDisks;
+        }
+        else if (!strcmp(argv[i], "--speed"))      opt.movesPerSec = atof(val());
+        else if (!strcmp(argv[i], "--replay"))     replayPath = val();
+        else if (!strcmp(argv[i], "--fullscreen")) fullscreen = true;
+        else if (!strcmp(argv[i], "--frames"))     frames = atol(val());
+        else usage();
+    }
+    if (opt.boards < 1 || opt.minDisks < 1 || opt.maxDisks < opt.minDisks ||
+        opt.maxDisks > Dashboard::MAX_DISKS || opt.movesPerSec <= 0)
+        usage();
+    if (replayPath && !(opt.replayDisks = loadReplay(replayPath, opt.replay))) return 2;
+
+    QApplication app(argc, argv);
+    app.setStyle("Fusion");
+
+    Dashboard d(opt);
+    d.resize(1280, 800);
+    if (fullscreen) d.showFullScreen();
+    else d.show();
+
+    if (frames > 0) {
+        d.keepAll = true;
+        QTimer done;
+        QObject::connect(&done, &QTimer::timeout, [&] {
+            if (d.frames() >= frames) { d.printStats(stdout); app.quit(); }
+        });
+        done.start(50);
+        return app.exec();
+    }
+    return app.exec();
+}
@@ -0,0 +1,204 @@
+// Streams the optimal solution for n disks to a file or stdout.
+//
+//   hanoi_export --disks n [--format text|csv|jsonl|binary] [--output file]
+//                [--threads T] [--rules classic|cyclic|adjacent|EDGES]
+//
+// text matches the in-game move log ("k. Disk d: A -> C"), binary is the packed
+// HNMV format read by hanoi_validate. Moves come from the closed-form generator
+// in solver.h; for large n, chunks of moves are formatted in parallel and
+// written in order, so memory stays at (threads × chunk) regardless of n.
+//
+// --rules picks a restricted-move variant (variant.h); EDGES is a list of
+// allowed moves such as "AB,BC,CA". The adjacent variant has a closed form and
+// is exported like the classic one; cyclic and other graphs are streamed from
+// VariantStream on one thread. The binary header records the rules, so
+// hanoi_validate checks the file against them.
+
+#include "movefile.h"
+#include "moveformat.h"
+#include "outbuf.h"
+#include "solver.h"
+#include "threadpool.h"
+#include "variant.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum ExportFormat { FMT_TEXT, FMT_CSV, FMT_JSONL, FMT_BINARY };
+
+static const uint64_t CHUNK_MOVES = 1 << 18;   // even, so binary chunks end on a byte
+
+// worst-case bytes per move including the newline
+static size_t bytesPerMove(ExportFormat f) {
+    switch (f) {
+    case FMT_TEXT:   return 20 + 7 + 2 + 2 + 6 + 1;
+    case FMT_CSV:    return 20 + 1 + 2 + 4 + 1;
+    case FMT_JSONL:  return 8 + 20 + 8 + 2 + 9 + 1 + 8 + 1 + 2 + 1;
+    case FMT_BINARY: return 1;
+    }
+    return MOVE_LINE_MAX;
+}
+
+// k-th move for the rule sets with a closed form
+static inline void closedFormMove(bool adjacent, int n, uint64_t k, int &disk, int &from, int &to) {
+    if (adjacent) adjacentMove(k, disk, from, to);
+    else          optimalMove(n, k, disk, from, to);
+}
+
+static inline char* formatMove(char *p, ExportFormat fmt, uint64_t k, int disk, int from, int to) {
+    if (fmt == FMT_TEXT)      p = formatMoveText(p, k, disk, from, to);
+    else if (fmt == FMT_CSV)  p = formatMoveCsv(p, k, disk, from, to);
+    else                      p = formatMoveJson(p, k, disk, from, to);
+    *p++ = '\n';
+    return p;
+}
+
+// formats moves [first, last] into p and returns the end
+static char* formatRange(char *p, ExportFormat fmt, bool adjacent, int n, uint64_t first, uint64_t last) {
+    int disk, from, to;
+    if (fmt == FMT_BINARY) {
+        for (uint64_t k = first; k <= last; k += 2) {
+            closedFormMove(adjacent, n, k, disk, from, to);
+            uint8_t b = packMove(from, to);
+            if (k + 1 <= last) {
+                closedFormMove(adjacent, n, k + 1, disk, from, to);
+                b |= (uint8_t)(packMove(from, to) << 4);
+            }
+            *p++ = (char)b;
+        }
+        return p;
+    }
+    for (uint64_t k = first; k <= last; k++) {
+        closedFormMove(adjacent, n, k, disk, from, to);
+        p = formatMove(p, fmt, k, disk, from, to);
+    }
+    return p;
+}
+
+// formats the next `count` moves of a streamed variant into p
+static char* formatStream(char *p, ExportFormat fmt, VariantStream &s, uint64_t count, uint8_t &half) {
+    int disk, from, to;
+    for (uint64_t i = 0; i < count && s.next(disk, from, to); i++) {
+        if (fmt != FMT_BINARY) { p = formatMove(p, fmt, s.emitted(), disk, from, to); continue; }
+        if (s.emitted() & 1) { half = packMove(from, to); continue; }   // low nibble first
+        *p++ = (char)(half | packMove(from, to) << 4);
+        half = 0;
+    }
+    return p;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_export --disks n [--format text|csv|jsonl|binary] [--output file]\n"
+            "                    [--threads T] [--rules classic|cyclic|adjacent|EDGES]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    int n = 0, threads = 0;
+    ExportFormat fmt = FMT_TEXT;
+    const char *path = nullptr;
+    MoveRules rules = MoveRules::classic();
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--disks")   n = atoi(val());
+        else if (a == "--threads") threads = atoi(val());
+        else if (a == "--output")  path = val();
+        else if (a == "--rules") {
+            if (!parseMoveRules(val(), rules)) usage();
+        }
+        else if (a == "--format") {
+            std::string f = val();
+            if      (f == "text")   fmt = FMT_TEXT;
+            else if (f == "csv")    fmt = FMT_CSV;
+            else if (f == "jsonl")  fmt = FMT_JSONL;
+            else if (f == "binary") fmt = FMT_BINARY;
+            else usage();
+        }
+        else usage();
+    }
+    const RulesKind kind = rules.kind();
+    const int maxDisks = kind == RULES_CLASSIC ? 64 : VariantSolver::MAX_DISKS;
+    if (n < 1 || n > maxDisks) {
+        fprintf(stderr, "hanoi_export: --disks must be 1..%d\n", maxDisks);
+        return 2;
+    }
+    VariantSolver solver(rules, n);
+    if (!solver.solvable()) {
+        fprintf(stderr, "hanoi_export: no solution from A to C with these moves\n");
+        return 2;
+    }
+    const bool adjacent = kind == RULES_ADJACENT;
+    const bool streamed = kind == RULES_CYCLIC || kind == RULES_GRAPH;
+
+    FILE *f = stdout;
+    if (path && strcmp(path, "-") != 0) {
+        f = fopen(path, "wb");
+        if (!f) { perror(path); return 2; }
+    }
+
+    const uint64_t total = kind == RULES_CLASSIC ? optimalMoveCount(n) : solver.moveCount();
+    {
+        OutputBuffer out(f);
+        if (fmt == FMT_BINARY) {
+            MoveFileHeader h = makeMoveFileHeader(n, total, rules.mask);
+            out.write(&h, sizeof h);
+        } else if (fmt == FMT_CSV) {
+            out.write("move,disk,from,to\n", 18);
+        }
+
+        ThreadPool pool(threads);
+        const size_t per = bytesPerMove(fmt);
+        if (streamed) {
+            // no random access: one VariantStream, chunk by chunk
+            VariantStream s(solver);
+            uint8_t half = 0;
+            for (uint64_t k = 1; k <= total && out.ok(); k += CHUNK_MOVES) {
+                uint64_t count = total - k < CHUNK_MOVES ? total - k + 1 : CHUNK_MOVES;
+                char *p = out.reserve((size_t)count * per + 1);
+                out.commit(formatStream(p, fmt, s, count, half));
+            }
+            if (fmt == FMT_BINARY && (total & 1)) out.write(&half, 1);
+        } else if (pool.size() == 1 || total <= CHUNK_MOVES) {
+            // serial: format straight into the output buffer
+            for (uint64_t k = 1; k <= total && out.ok(); k += CHUNK_MOVES) {
+                uint64_t last = total - k < CHUNK_MOVES ? total : k + CHUNK_MOVES - 1;
+                char *p = out.reserve((size_t)(last - k + 1) * per);
+                out.commit(formatRange(p, fmt, adjacent, n, k, last));
+            }
+        } else {
+            // parallel: one round formats `size` chunks side by side, then they
+            // are written in order straight from the chunk buffers
+            const size_t slots = (size_t)pool.size();
+            std::vector<std::vector<char>> bufs(slots, std::vector<char>(CHUNK_MOVES * per));
+            std::vector<size_t> lens(slots);
+            for (uint64_t k = 1; k <= total && out.ok();) {
+                uint64_t roundFirst = k;
+                pool.parallelFor(slots, [&](size_t b, size_t e) {
+                    for (size_t s = b; s < e; s++) {
+                        uint64_t first = roundFirst + s * CHUNK_MOVES;
+                        if (first > total || first < roundFirst) { lens[s] = 0; continue; }
+                        uint64_t last = total - first < CHUNK_MOVES ? total : first + CHUNK_MOVES - 1;
+                        lens[s] = (size_t)(formatRange(bufs[s].data(), fmt, adjacent, n, first, last) - bufs[s].data());
+                    }
+                }, 1);
+                for (size_t s = 0; s < slots; s++)
+                    if (lens[s]) out.writeBlock(bufs[s].data(), lens[s]);
+                uint64_t step = CHUNK_MOVES * slots;
+                if (total - (k - 1) <= step) break;
+                k += step;
+            }
+        }
+        out.flush();
+        if (!out.ok()) {
+            fprintf(stderr, "hanoi_export: write failed\n");
+            if (f != stdout) fclose(f);
+            return 1;
+        }
+    }
+    if (f != stdout) fclose(f);
+    return 0;
+}
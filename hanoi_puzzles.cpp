@@ -0,0 +1,275 @@
+// Random puzzle generator: unique legal positions, or start/goal pairs, each
+// labelled with its exact optimal distance. Used for challenge levels and
+// test corpora.
+//
+//   hanoi_puzzles --disks n --count N [--pairs] [--target A|B|C] [--seed S]
+//                 [--format csv|jsonl] [--output file] [--threads T]
+//
+// A position is written as one peg letter per disk from the largest down
+// ("CAB" = disk 3 on C, disk 2 on A, disk 1 on B) plus, for single positions,
+// its base-3 code (digit k-1 = peg of disk k). Single positions are measured
+// to the all-on-target tower (distanceToPeg), pairs from start to goal
+// (positionDistance); both are closed forms, no search.
+//
+// Every disk on a uniform random peg is a uniform random legal position.
+// Candidates are drawn in chunks of CHUNK, each from its own generator seeded
+// by (seed, chunk number), and measured and formatted on the thread pool;
+// duplicates are then dropped in chunk order through an open-addressing set
+// of codes, so the output depends only on the seed, never on --threads.
+// Singles go up to 40 disks and pairs up to 20, where a code (or a pair of
+// codes) still fits 64 bits.
+
+#include "outbuf.h"
+#include "moveformat.h"
+#include "solver.h"
+#include "threadpool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum PuzzleFormat { FMT_CSV, FMT_JSONL };
+
+static const size_t CHUNK = 1 << 14;   // candidates per generator
+static const int LINE_BYTES = 160;      // longest formatted line, pairs of 20 in JSONL
+static const char PEG_CHARS[3] = {'A', 'B', 'C'};
+
+// splitmix64, seeded per chunk so every chunk draws the same candidates
+// whichever worker runs it
+struct Rng {
+    uint64_t s;
+    explicit Rng(uint64_t seed) : s(seed) {}
+    uint64_t next() {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    // uniform in [0, bound), without modulo bias
+    uint64_t below(uint64_t bound) {
+        uint64_t limit = ~0ULL - ~0ULL % bound;
+        uint64_t v;
+        do v = next(); while (v >= limit);
+        return v % bound;
+    }
+};
+
+// Open-addressing set of 64-bit codes (linear probing, at most half full).
+// Codes are below 3^40 or 9^20, so ~0 never occurs and marks an empty slot.
+class CodeSet {
+public:
+    explicit CodeSet(uint64_t expected) : used(0) {
+        size_t cap = 64;
+        while (cap < expected * 2) cap <<= 1;
+        slots.assign(cap, EMPTY);
+    }
+
+    // true if `code` was not in the set yet
+    bool insert(uint64_t code) {
+        if ((used + 1) * 2 > slots.size()) grow();
+        size_t mask = slots.size() - 1;
+        for (size_t i = mix(code) & mask;; i = (i + 1) & mask) {
+            if (slots[i] == code) return false;
+            if (slots[i] == EMPTY) { slots[i] = code; used++; return true; }
+        }
+    }
+
+    size_t size() const { return used; }
+    size_t bytes() const { return slots.size() * sizeof(uint64_t); }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ULL;
+    std::vector<uint64_t> slots;
+    size_t used;
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        return x ^ (x >> 33);
+    }
+
+    void grow() {
+        std::vector<uint64_t> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, EMPTY);
+        used = 0;
+        for (uint64_t c : old)
+            if (c != EMPTY) insert(c);
+    }
+};
+
+// one chunk of candidates: dedupe keys and their formatted lines
+struct Chunk {
+    std::vector<uint64_t> key;
+    std::vector<uint32_t> end;   // line i is [end[i-1], end[i])
+    std::vector<char>     text;
+};
+
+static void decode(uint64_t code, int n, uint64_t peg[3]) {
+    peg[0] = peg[1] = peg[2] = 0;
+    for (int k = 1; k <= n; k++, code /= 3) peg[code % 3] |= 1ULL << (k - 1);
+}
+
+static char* writePosition(char *p, uint64_t code, int n) {
+    char *q = p + n;
+    for (int k = 0; k < n; k++, code /= 3) q[-1 - k] = PEG_CHARS[code % 3];
+    return q;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_puzzles --disks n --count N [--pairs] [--target A|B|C] [--seed S]\n"
+            "                     [--format csv|jsonl] [--output file] [--threads T]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    int n = 0, threads = 0, target = 2;
+    uint64_t count = 0, seed = 1;
+    bool pairs = false;
+    PuzzleFormat fmt = FMT_CSV;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--disks")   n = atoi(val());
+        else if (a == "--count")   count = strtoull(val(), nullptr, 10);
+        else if (a == "--pairs")   pairs = true;
+        else if (a == "--seed")    seed = strtoull(val(), nullptr, 10);
+        else if (a == "--threads") threads = atoi(val());
+        else if (a == "--output")  path = val();
+        else if (a == "--target") {
+            const char *t = val();
+            if (t[0] < 'A' || t[0] > 'C' || t[1]) usage();
+            target = t[0] - 'A';
+        }
+        else if (a == "--format") {
+            std::string f = val();
+            if      (f == "csv")   fmt = FMT_CSV;
+            else if (f == "jsonl") fmt = FMT_JSONL;
+            else usage();
+        }
+        else usage();
+    }
+    const int maxDisks = pairs ? 20 : 40;
+    if (n < 1 || n > maxDisks) {
+        fprintf(stderr, "hanoi_puzzles: --disks must be 1..%d%s\n", maxDisks, pairs ? " with --pairs" : "");
+        return 2;
+    }
+    if (count == 0) usage();
+
+    uint64_t states = 1;
+    for (int k = 0; k < n; k++) states *= 3;
+    const uint64_t space = pairs ? states * states : states;
+    if (count > space) {
+        fprintf(stderr, "hanoi_puzzles: only %llu distinct %s for %d disks\n",
+                (unsigned long long)space, pairs ? "pairs" : "positions", n);
+        count = space;
+    }
+
+    FILE *f = stdout;
+    if (path && strcmp(path, "-") != 0) {
+        f = fopen(path, "wb");
+        if (!f) { perror(path); return 2; }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    ThreadPool pool(threads);
+    const size_t slots = (size_t)pool.size();
+    std::vector<Chunk> chunks(slots);
+    for (Chunk &c : chunks) {
+        c.key.resize(CHUNK);
+        c.end.resize(CHUNK);
+        c.text.resize(CHUNK * LINE_BYTES);
+    }
+
+    CodeSet seen(count);
+    uint64_t written = 0, drawn = 0;
+    bool ok;
+    {
+        OutputBuffer out(f);
+        if (fmt == FMT_CSV)
+            out.write(pairs ? "start,goal,distance\n" : "position,code,distance\n", pairs ? 20 : 23);
+
+        for (uint64_t round = 0; written < count && out.ok(); round++) {
+            pool.parallelFor(slots, [&](size_t b, size_t e) {
+                for (size_t s = b; s < e; s++) {
+                    Chunk &c = chunks[s];
+                    Rng rng(seed * 0x2545F4914F6CDD1DULL + round * slots + s);
+                    char *p = c.text.data();
+                    for (size_t i = 0; i < CHUNK; i++) {
+                        uint64_t a = rng.below(states), pa[3];
+                        decode(a, n, pa);
+                        if (pairs) {
+                            uint64_t g = rng.below(states), pg[3];
+                            decode(g, n, pg);
+                            c.key[i] = a * states + g;
+                            uint64_t d = positionDistance(pa, pg, n);
+                            if (fmt == FMT_CSV) {
+                                p = writePosition(p, a, n);
+                                *p++ = ',';
+                                p = writePosition(p, g, n);
+                                *p++ = ',';
+                            } else {
+                                p = writeLit(p, "{\"start\":\"", 10);
+                                p = writePosition(p, a, n);
+                                p = writeLit(p, "\",\"goal\":\"", 10);
+                                p = writePosition(p, g, n);
+                                p = writeLit(p, "\",\"distance\":", 13);
+                            }
+                            p = writeUInt(p, d);
+                        } else {
+                            c.key[i] = a;
+                            uint64_t d = distanceToPeg(pa[0], pa[1], n, target);
+                            if (fmt == FMT_CSV) {
+                                p = writePosition(p, a, n);
+                                *p++ = ',';
+                                p = writeUInt(p, a);
+                                *p++ = ',';
+                            } else {
+                                p = writeLit(p, "{\"position\":\"", 13);
+                                p = writePosition(p, a, n);
+                                p = writeLit(p, "\",\"code\":", 9);
+                                p = writeUInt(p, a);
+                                p = writeLit(p, ",\"target\":\"", 11);
+                                *p++ = PEG_CHARS[target];
+                                p = writeLit(p, "\",\"distance\":", 13);
+                            }
+                            p = writeUInt(p, d);
+                        }
+                        if (fmt == FMT_JSONL) *p++ = '}';
+                        *p++ = '\n';
+                        c.end[i] = (uint32_t)(p - c.text.data());
+                    }
+                }
+            }, 1);
+
+            // dedupe in chunk order: the same seed gives the same file on any pool
+            for (size_t s = 0; s < slots && written < count; s++) {
+                const Chunk &c = chunks[s];
+                for (size_t i = 0; i < CHUNK && written < count; i++) {
+                    drawn++;
+                    if (!seen.insert(c.key[i])) continue;
+                    uint32_t b = i ? c.end[i - 1] : 0;
+                    out.write(c.text.data() + b, c.end[i] - b);
+                    written++;
+                }
+            }
+        }
+        out.flush();
+        ok = out.ok();
+    }
+    if (f != stdout && fclose(f) != 0) ok = false;
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "hanoi_puzzles: %llu %s (%llu drawn, %llu duplicates, set %.1f MB) in %.2f s on %zu threads\n",
+            (unsigned long long)written, pairs ? "pairs" : "positions", (unsigned long long)drawn,
+            (unsigned long long)(drawn - written), seen.bytes() / 1048576.0, secs, slots);
+    if (!ok) {
+        fprintf(stderr, "hanoi_puzzles: write failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+// Command-line client for hanoi_daemon, and a throughput check for it.
+//
+//   hanoi_query [--socket path] move n k
+//   hanoi_query [--socket path] state n k
+//   hanoi_query [--socket path] distance n START GOAL
+//   hanoi_query [--socket path] tower n POSITION [A|B|C]
+//   hanoi_query [--socket path] next n POSITION [A|B|C]
+//   hanoi_query [--socket path] range n first count
+//   hanoi_query [--socket path] bench n [--queries N] [--batch B] [--depth D]
+//
+// Positions are one peg letter per disk from the largest down, as written by
+// hanoi_puzzles ("CAB" = disk 3 on C, disk 2 on A, disk 1 on B). `range`
+// prints moves in the move-log text format, fetching SOLVER_MAX_RANGE moves
+// per query with up to four queries in flight. `bench` sends N random
+// k-th-move / next-move / distance queries in batches of B (default 256)
+// with D batches in flight (default 4) and reports queries per second.
+// Exit status: 0 ok, 1 query rejected or daemon unreachable, 2 usage.
+
+#include "moveformat.h"
+#include "outbuf.h"
+#include "solverproto.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const char *STATUS_NAMES[] = {"ok", "bad op", "bad arguments", "already solved", "too large"};
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_query [--socket path] move|state n k\n"
+            "       hanoi_query [--socket path] distance n START GOAL\n"
+            "       hanoi_query [--socket path] tower|next n POSITION [A|B|C]\n"
+            "       hanoi_query [--socket path] range n first count\n"
+            "       hanoi_query [--socket path] bench n [--queries N] [--batch B] [--depth D]\n");
+    exit(2);
+}
+
+// "CAB" -> peg A / peg B masks
+static void parsePosition(const char *s, int n, uint64_t &a, uint64_t &b) {
+    if ((int)strlen(s) != n) usage();
+    a = b = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t bit = 1ULL << (n - 1 - i);
+        if      (s[i] == 'A') a |= bit;
+        else if (s[i] == 'B') b |= bit;
+        else if (s[i] != 'C') usage();
+    }
+}
+
+static void printPosition(const uint64_t peg[3], int n) {
+    for (int k = n; k >= 1; k--) {
+        uint64_t bit = 1ULL << (k - 1);
+        putchar(peg[0] & bit ? 'A' : peg[1] & bit ? 'B' : 'C');
+    }
+    putchar('\n');
+}
+
+static int parsePeg(const char *s) {
+    if (s[0] < 'A' || s[0] > 'C' || s[1]) usage();
+    return s[0] - 'A';
+}
+
+static bool roundTrip(SolverClient &c, SolverQuery &q, SolverResult &r) {
+    SolverReplyHeader h;
+    std::vector<SolverResult> res;
+    std::vector<uint8_t> payload;
+    if (!c.send(1, &q, 1) || !c.receive(h, res, payload) || h.count != 1) {
+        fprintf(stderr, "hanoi_query: lost connection to the daemon\n");
+        return false;
+    }
+    r = res[0];
+    if (r.status == SOLVER_OK) return true;
+    fprintf(stderr, "hanoi_query: %s\n", r.status < 5 ? STATUS_NAMES[r.status] : "unknown status");
+    return false;
+}
+
+// streams moves first..first+count-1 as text, keeping a few queries in flight
+static int range(SolverClient &c, int n, uint64_t first, uint64_t count) {
+    const int DEPTH = 4;
+    OutputBuffer out(stdout);
+    uint64_t sentUpTo = first, end = first + count;
+    int inFlight = 0;
+    SolverReplyHeader h;
+    std::vector<SolverResult> res;
+    std::vector<uint8_t> payload;
+    uint64_t k = first;
+    while (k < end) {
+        while (inFlight < DEPTH && sentUpTo < end) {
+            SolverQuery q = {};
+            q.op = SOLVER_MOVE_RANGE;
+            q.n = (uint8_t)n;
+            q.arg[0] = sentUpTo;
+            q.arg[1] = std::min(end - sentUpTo, SOLVER_MAX_RANGE);
+            if (!c.send((uint32_t)inFlight, &q, 1)) break;
+            sentUpTo += q.arg[1];
+            inFlight++;
+        }
+        if (!c.receive(h, res, payload) || h.count != 1) {
+            fprintf(stderr, "hanoi_query: lost connection to the daemon\n");
+            return 1;
+        }
+        inFlight--;
+        if (res[0].status != SOLVER_OK) {
+            fprintf(stderr, "hanoi_query: %s\n", res[0].status < 5 ? STATUS_NAMES[res[0].status] : "unknown status");
+            return 1;
+        }
+        for (uint64_t i = 0; i < res[0].value[0]; i++, k++) {
+            uint8_t nib = (uint8_t)(payload[i >> 1] >> (i & 1 ? 4 : 0) & 0x0F);
+            char *p = out.reserve(MOVE_LINE_MAX);
+            p = formatMoveText(p, k, __builtin_ctzll(k) + 1, nib >> 2, nib & 3);
+            *p++ = '\n';
+            out.commit(p);
+        }
+        if (res[0].value[0] == 0) break;
+    }
+    out.flush();
+    return out.ok() ? 0 : 1;
+}
+
+static int bench(SolverClient &c, int n, uint64_t queries, uint32_t batch, int depth) {
+    const uint64_t moves = (1ULL << n) - 1;
+    uint64_t s = 0x9E3779B97F4A7C15ULL;
+    auto rnd = [&s]() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; };
+    std::vector<SolverQuery> q(batch);
+    SolverReplyHeader h;
+    std::vector<SolverResult> res;
+    std::vector<uint8_t> payload;
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t sent = 0, answered = 0, failed = 0;
+    int inFlight = 0;
+    uint32_t id = 0;
+    while (answered < queries) {
+        while (inFlight < depth && sent < queries) {
+            uint32_t count = (uint32_t)std::min<uint64_t>(batch, queries - sent);
+            for (uint32_t i = 0; i < count; i++) {
+                SolverQuery &x = q[i];
+                x = SolverQuery{};
+                x.n = (uint8_t)n;
+                uint64_t a = rnd() & moves, b = rnd() & moves & ~a;
+                switch (i % 3) {
+                case 0: x.op = SOLVER_MOVE_AT; x.arg[0] = rnd() % moves + 1; break;
+                case 1: x.op = SOLVER_NEXT_MOVE; x.arg[0] = a; x.arg[1] = b; x.target = 2; break;
+                case 2: x.op = SOLVER_DISTANCE; x.arg[0] = a; x.arg[1] = b; x.arg[2] = b; x.arg[3] = a; break;
+                }
+            }
+            if (!c.send(id++, q.data(), count)) break;
+            sent += count;
+            inFlight++;
+        }
+        if (!c.receive(h, res, payload)) {
+            fprintf(stderr, "hanoi_query: lost connection to the daemon\n");
+            return 1;
+        }
+        inFlight--;
+        answered += h.count;
+        for (const SolverResult &r : res)
+            if (r.status != SOLVER_OK && r.status != SOLVER_SOLVED) failed++;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%llu queries in %.3f s: %.0f queries/s (batch %u, %d in flight, %llu rejected)\n",
+           (unsigned long long)answered, secs, answered / secs, batch, depth, (unsigned long long)failed);
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    std::string path = defaultSolverSocket();
+    uint64_t queries = 1000000;
+    uint32_t batch = 256;
+    int depth = 4;
+    std::vector<const char *> args;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--socket")  path = val();
+        else if (a == "--queries") queries = strtoull(val(), nullptr, 10);
+        else if (a == "--batch")   batch = (uint32_t)strtoul(val(), nullptr, 10);
+        else if (a == "--depth")   depth = atoi(val());
+        else if (a.size() > 1 && a[0] == '-') usage();
+        else args.push_back(argv[i]);
+    }
+    if (args.size() < 2) usage();
+    const std::string cmd = args[0];
+    const int n = atoi(args[1]);
+    if (n < 1 || n > SOLVER_MAX_DISKS) {
+        fprintf(stderr, "hanoi_query: n must be 1..%d\n", SOLVER_MAX_DISKS);
+        return 2;
+    }
+    if (batch < 1 || batch > SOLVER_MAX_BATCH || depth < 1) usage();
+
+    SolverClient c;
+    if (!c.connect(path)) {
+        fprintf(stderr, "hanoi_query: cannot reach the daemon at %s: %s\n", path.c_str(), strerror(errno));
+        return 1;
+    }
+
+    SolverQuery q = {};
+    SolverResult r;
+    q.n = (uint8_t)n;
+    if (cmd == "move" || cmd == "state") {
+        if (args.size() != 3) usage();
+        q.op = cmd == "move" ? SOLVER_MOVE_AT : SOLVER_STATE_AT;
+        q.arg[0] = strtoull(args[2], nullptr, 10);
+        if (!roundTrip(c, q, r)) return 1;
+        if (cmd == "move") printf("Disk %d: %c -> %c\n", r.disk, 'A' + r.from, 'A' + r.to);
+        else               printPosition(r.value, n);
+    } else if (cmd == "distance") {
+        if (args.size() != 4) usage();
+        q.op = SOLVER_DISTANCE;
+        parsePosition(args[2], n, q.arg[0], q.arg[1]);
+        parsePosition(args[3], n, q.arg[2], q.arg[3]);
+        if (!roundTrip(c, q, r)) return 1;
+        printf("%llu\n", (unsigned long long)r.value[0]);
+    } else if (cmd == "tower" || cmd == "next") {
+        if (args.size() != 3 && args.size() != 4) usage();
+        q.op = cmd == "tower" ? SOLVER_TOWER_DISTANCE : SOLVER_NEXT_MOVE;
+        parsePosition(args[2], n, q.arg[0], q.arg[1]);
+        q.target = (uint8_t)(args.size() == 4 ? parsePeg(args[3]) : 2);
+        if (!roundTrip(c, q, r)) return r.status == SOLVER_SOLVED ? 0 : 1;
+        if (cmd == "tower") printf("%llu\n", (unsigned long long)r.value[0]);
+        else printf("Disk %d: %c -> %c (%llu moves left)\n", r.disk, 'A' + r.from, 'A' + r.to,
+                    (unsigned long long)r.value[0]);
+    } else if (cmd == "range") {
+        if (args.size() != 4) usage();
+        uint64_t first = strtoull(args[2], nullptr, 10), count = strtoull(args[3], nullptr, 10);
+        uint64_t total = (1ULL << n) - 1;
+        if (first < 1 || first > total || count == 0) usage();
+        return range(c, n, first, std::min(count, total - first + 1));
+    } else if (cmd == "bench") {
+        if (args.size() != 2 || queries == 0) usage();
+        return bench(c, n, queries, batch, depth);
+    } else {
+        usage();
+    }
+    return 0;
+}
@@ -0,0 +1,270 @@
+// Offscreen exporter: renders a whole optimal solve as frames, no window.
+//
+//   hanoi_render --disks n [--format png|ppm|raw] [--output PATTERN|file|-]
+//                [--move-frames F] [--hold FRAMES] [--scale S] [--threads T]
+//
+// Frames look like the game board (BoardPainter: the scene's rods, disks and
+// title) with each move flown along the same bezier arc as onAnimStep, F
+// frames per move, plus `hold` still frames at the start and the end.
+//
+// png / ppm write one file per frame; PATTERN holds exactly one %d, %Nd or
+// %0Nd for the frame number and no other '%' (default frame_%06d.png /
+// frame_%06d.ppm). It is expanded by FramePattern, not printf. raw writes
+// RGB24 frames back to back to a file or stdout for an external encoder:
+//
+//   hanoi_render --disks 10 --format raw |
+//       ffmpeg -f rawvideo -pix_fmt rgb24 -s 750x400 -r 60 -i - hanoi10.mp4
+//
+// Frames are rasterised in rounds: every worker thread renders a batch of
+// consecutive frames with its own QImage and QPainter (and encodes and saves
+// them for png/ppm); raw batches are then written in order. Memory stays at
+// threads x BATCH frames whatever the number of moves.
+
+#include "boardpainter.h"
+#include "solver.h"
+#include "threadpool.h"
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum RenderFormat { FMT_PNG, FMT_PPM, FMT_RAW };
+
+static const int BATCH = 4;   // frames per worker per round
+
+// One frame: the disks at rest plus, optionally, one disk on its arc.
+struct FrameSpec {
+    uint64_t peg[3];
+    int      disk;        // 0 = nothing in the air
+    float    sx, sy, ex, ey, t;
+};
+
+struct Renderer {
+    BoardPainter bp;
+    QImage       img;
+    double       scale;
+
+    std::vector<uint8_t> ppm;   // reused PPM body
+
+    Renderer(int n, int w, int h, double s) : bp(n), img(w, h, QImage::Format_RGB32), scale(s) {}
+
+    void render(const FrameSpec &f) {
+        QPainter p(&img);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.scale(scale, scale);
+        bp.paintBackground(p, QRect(0, 0, BoardPainter::SCENE_W, BoardPainter::SCENE_H));
+        int disks[64];
+        for (int i = 0; i < 3; i++) {
+            int c = 0;
+            for (int k = bp.numDisks(); k >= 1; k--)   // bottom (largest) first
+                if (f.peg[i] >> (k - 1) & 1) disks[c++] = k;
+            bp.paintRod(p, i, disks, c, false, false);
+        }
+        if (f.disk) {
+            QRect r = bp.diskRect(BoardPainter::arcPos(f.sx, f.sy, f.ex, f.ey, f.t), f.disk);
+            bp.paintDisk(p, f.disk, r.x(), r.y(), false);
+        }
+    }
+
+    // packed RGB24, the layout of both PPM bodies and rawvideo rgb24
+    void toRgb24(uint8_t *out) const {
+        for (int y = 0; y < img.height(); y++) {
+            const QRgb *line = (const QRgb*)img.constScanLine(y);
+            for (int x = 0; x < img.width(); x++) {
+                *out++ = (uint8_t)qRed(line[x]);
+                *out++ = (uint8_t)qGreen(line[x]);
+                *out++ = (uint8_t)qBlue(line[x]);
+            }
+        }
+    }
+};
+
+// --output for png / ppm, split around its single %[0][width]d
+struct FramePattern {
+    std::string head, tail;
+    int  width = 0;
+    bool zero = false;
+
+    bool parse(const std::string &s) {
+        size_t at = s.find('%');
+        if (at == std::string::npos) return false;
+        size_t i = at + 1;
+        zero = i < s.size() && s[i] == '0';
+        width = 0;
+        for (; i < s.size() && s[i] >= '0' && s[i] <= '9' && width < 100; i++) width = width * 10 + (s[i] - '0');
+        if (i >= s.size() || s[i] != 'd' || s.find('%', i) != std::string::npos) return false;
+        head = s.substr(0, at);
+        tail = s.substr(i + 1);
+        return true;
+    }
+
+    std::string path(uint64_t frame) const {
+        std::string num = std::to_string(frame);
+        if ((int)num.size() < width) num.insert(0, (size_t)width - num.size(), zero ? '0' : ' ');
+        return head + num + tail;
+    }
+};
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_render --disks n [--format png|ppm|raw] [--output PATTERN|file|-]\n"
+            "                    [--move-frames F] [--hold FRAMES] [--scale S] [--threads T]\n");
+    exit(2);
+}
+
+static int popcount(uint64_t m) { return __builtin_popcountll(m); }
+
+int main(int argc, char *argv[]) {
+    int n = 0, moveFrames = 12, hold = 30, threads = 0;
+    double scale = 1.0;
+    RenderFormat fmt = FMT_PNG;
+    const char *output = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--disks")       n = atoi(val());
+        else if (a == "--move-frames") moveFrames = atoi(val());
+        else if (a == "--hold")        hold = atoi(val());
+        else if (a == "--scale")       scale = atof(val());
+        else if (a == "--threads")     threads = atoi(val());
+        else if (a == "--output")      output = val();
+        else if (a == "--format") {
+            std::string f = val();
+            if      (f == "png") fmt = FMT_PNG;
+            else if (f == "ppm") fmt = FMT_PPM;
+            else if (f == "raw") fmt = FMT_RAW;
+            else usage();
+        }
+        else usage();
+    }
+    if (n < 1 || n > 30) {
+        fprintf(stderr, "hanoi_render: --disks must be 1..30\n");
+        return 2;
+    }
+    if (moveFrames < 1 || hold < 0 || scale <= 0 || scale > 8) usage();
+    std::string pattern = output ? output : fmt == FMT_PNG ? "frame_%06d.png"
+                                          : fmt == FMT_PPM ? "frame_%06d.ppm" : "-";
+    FramePattern names;
+    if (fmt != FMT_RAW && !names.parse(pattern)) {
+        fprintf(stderr, "hanoi_render: --output needs exactly one %%d, %%Nd or %%0Nd and no other %% for %s\n",
+                fmt == FMT_PNG ? "png" : "ppm");
+        return 2;
+    }
+
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);   // fonts; nothing is shown
+
+    // even dimensions, as most video encoders require
+    const int W = (int)std::lround(BoardPainter::SCENE_W * scale) & ~1;
+    const int H = (int)std::lround(BoardPainter::SCENE_H * scale) & ~1;
+    const size_t frameBytes = (size_t)W * H * 3;
+
+    FILE *raw = nullptr;
+    if (fmt == FMT_RAW) {
+        raw = pattern == "-" ? stdout : fopen(pattern.c_str(), "wb");
+        if (!raw) { perror(pattern.c_str()); return 2; }
+    }
+
+    ThreadPool pool(threads);
+    const size_t workers = (size_t)pool.size();
+    std::vector<Renderer*> rend;
+    for (size_t s = 0; s < workers; s++) rend.push_back(new Renderer(n, W, H, W / (double)BoardPainter::SCENE_W));
+    std::vector<std::vector<uint8_t>> rgb(fmt == FMT_RAW ? workers : 0, std::vector<uint8_t>(BATCH * frameBytes));
+    std::vector<int> failed(workers, 0);
+
+    const uint64_t moves = optimalMoveCount(n);
+    const uint64_t total = (uint64_t)hold * 2 + moves * (uint64_t)moveFrames;
+    BoardPainter geo(n);
+    uint64_t peg[3] = {fullTowerMask(n), 0, 0};   // all disks on A
+    uint64_t move = 0;                            // moves fully applied
+    int sub = 0;                                  // frame within the current move
+    uint64_t frame = 0;
+
+    QElapsedTimer clock;
+    clock.start();
+    std::vector<FrameSpec> specs(workers * BATCH);
+    bool ok = true;
+    while (frame < total && ok) {
+        // lay out the next round's frames in order; cheap, so done serially
+        size_t count = 0;
+        for (; count < specs.size() && frame + count < total; count++) {
+            FrameSpec &f = specs[count];
+            uint64_t i = frame + count;
+            f.disk = 0;
+            if (i >= (uint64_t)hold && move < moves) {
+                int disk, from, to;
+                optimalMove(n, move + 1, disk, from, to);
+                uint64_t bit = 1ULL << (disk - 1);
+                f.peg[0] = peg[0]; f.peg[1] = peg[1]; f.peg[2] = peg[2];
+                f.peg[from] &= ~bit;
+                f.disk = disk;
+                f.sx = BoardPainter::towerX(from);
+                f.sy = BoardPainter::baseY() - (popcount(f.peg[from]) + 1) * geo.diskH();
+                f.ex = BoardPainter::towerX(to);
+                f.ey = BoardPainter::baseY() - (popcount(f.peg[to]) + 1) * geo.diskH();
+                f.t = (float)(sub + 1) / moveFrames;
+                if (++sub == moveFrames) {   // landed: the next frame starts the next move
+                    peg[from] &= ~bit;
+                    peg[to] |= bit;
+                    move++;
+                    sub = 0;
+                }
+            } else {
+                f.peg[0] = peg[0]; f.peg[1] = peg[1]; f.peg[2] = peg[2];
+            }
+        }
+
+        const uint64_t first = frame;
+        pool.parallelFor(workers, [&](size_t b, size_t e) {
+            for (size_t s = b; s < e; s++) {
+                for (size_t j = s * BATCH; j < (s + 1) * BATCH && j < count; j++) {
+                    Renderer &r = *rend[s];
+                    r.render(specs[j]);
+                    if (fmt == FMT_RAW) {
+                        r.toRgb24(rgb[s].data() + (j - s * BATCH) * frameBytes);
+                        continue;
+                    }
+                    const std::string name = names.path(first + j);
+                    const char *path = name.c_str();
+                    if (fmt == FMT_PNG) {
+                        if (!r.img.save(path, "PNG")) failed[s] = 1;
+                        continue;
+                    }
+                    FILE *f = fopen(path, "wb");
+                    if (!f) { failed[s] = 1; continue; }
+                    r.ppm.resize(frameBytes);
+                    r.toRgb24(r.ppm.data());
+                    fprintf(f, "P6\n%d %d\n255\n", W, H);
+                    if (fwrite(r.ppm.data(), 1, frameBytes, f) != frameBytes) failed[s] = 1;
+                    if (fclose(f) != 0) failed[s] = 1;
+                }
+            }
+        }, 1);
+
+        for (size_t s = 0; s < workers; s++) {
+            if (failed[s]) ok = false;
+            if (!raw || s * BATCH >= count) continue;
+            size_t frames = std::min((size_t)BATCH, count - s * BATCH);
+            if (fwrite(rgb[s].data(), 1, frames * frameBytes, raw) != frames * frameBytes) ok = false;
+        }
+        frame += count;
+    }
+    if (raw && raw != stdout && fclose(raw) != 0) ok = false;
+    if (raw == stdout && fflush(stdout) != 0) ok = false;
+    for (Renderer *r : rend) delete r;
+
+    double secs = clock.elapsed() / 1000.0;
+    fprintf(stderr, "hanoi_render: %llu frames (%dx%d) in %.1f s, %.0f frames/s on %zu threads\n",
+            (unsigned long long)frame, W, H, secs, secs > 0 ? frame / secs : 0.0, workers);
+    if (!ok) {
+        fprintf(stderr, "hanoi_render: write failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,242 @@
+// Headless batch simulator: plays many randomized or scripted games through the
+// rules engine and reports move counts, illegal-move rate and distance to optimal.
+//
+//   hanoi_sim [--games N] [--disks n] [--mode random|noisy|optimal] [--eps p]
+//             [--max-moves M] [--threads T] [--seed S] [--engine] [--scaling]
+//
+// --engine drives every game through Game::moveDisk instead of the compact
+// bitmask board and prints the peak bytes held by each engine container;
+// --scaling repeats the run for 1, 2, 4 … T threads.
+
+#include "arena.h"
+#include "game.h"
+#include "solver.h"
+#include "workstealing.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum SimMode { MODE_RANDOM, MODE_NOISY, MODE_OPTIMAL };
+
+struct SimConfig {
+    uint64_t games   = 100000;
+    int      disks   = 6;
+    SimMode  mode    = MODE_NOISY;
+    double   eps     = 0.1;       // chance of a random action in noisy mode
+    uint64_t maxMoves = 0;        // 0 = 20 × optimal
+    int      threads = 0;
+    uint64_t seed    = 1;
+    bool     engine  = false;
+    bool     scaling = false;
+};
+
+struct alignas(64) SimStats {
+    uint64_t games = 0, solved = 0;
+    uint64_t moves = 0, illegal = 0;
+    uint64_t excessMoves = 0;        // solved games: moves beyond 2^n - 1
+    uint64_t optimalGames = 0;       // solved in exactly 2^n - 1
+    uint64_t unsolvedDistance = 0;   // unsolved games: optimal moves still left
+
+    void merge(const SimStats &o) {
+        games += o.games; solved += o.solved;
+        moves += o.moves; illegal += o.illegal;
+        excessMoves += o.excessMoves; optimalGames += o.optimalGames;
+        unsolvedDistance += o.unsolvedDistance;
+    }
+};
+
+// small per-game generator, seeded from (seed, game index) so results do not
+// depend on the thread count or on which worker ran the game
+struct Rng {
+    uint64_t s;
+    explicit Rng(uint64_t seed) : s(seed) {}
+    uint64_t next() {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// per-game state, carved from the worker's arena and dropped wholesale after the game
+struct SimBoard {
+    uint64_t peg[3];
+    uint8_t *trace;       // (from << 2 | to) per legal move
+    uint64_t len;
+    Game    *engine;      // only with --engine
+};
+
+static const char *PEG_NAMES[3] = {"A", "B", "C"};
+
+static bool applyMove(SimBoard &b, int from, int to) {
+    if (b.engine) {
+        Tower *src = b.engine->getTower(PEG_NAMES[from]);
+        int disk = src->top();
+        if (!b.engine->moveDisk(PEG_NAMES[from], PEG_NAMES[to])) return false;
+        uint64_t bit = 1ULL << (disk - 1);
+        b.peg[from] ^= bit;
+        b.peg[to]   ^= bit;
+    } else {
+        // same rules as Game::moveDisk: source non-empty, no larger disk on a smaller one
+        uint64_t s = b.peg[from], d = b.peg[to];
+        if (from == to || s == 0) return false;
+        uint64_t top = s & (0 - s);
+        if (d != 0 && (d & (0 - d)) < top) return false;
+        b.peg[from] ^= top;
+        b.peg[to]   ^= top;
+    }
+    b.trace[b.len++] = (uint8_t)(from << 2 | to);
+    return true;
+}
+
+static void playGame(const SimConfig &cfg, uint64_t index, Arena &arena, SimStats &st) {
+    const int n = cfg.disks;
+    const uint64_t optimal = optimalMoveCount(n);
+    const uint64_t full = fullTowerMask(n);
+    const uint64_t limit = cfg.maxMoves ? cfg.maxMoves : optimal * 20;
+
+    arena.reset();
+    SimBoard *b = static_cast<SimBoard*>(arena.alloc(sizeof(SimBoard), alignof(SimBoard)));
+    b->peg[0] = full; b->peg[1] = 0; b->peg[2] = 0;
+    b->trace = arena.allocArray<uint8_t>(limit);
+    b->len = 0;
+    b->engine = nullptr;
+    if (cfg.engine) {
+        b->engine = new (arena.alloc(sizeof(Game), alignof(Game))) Game();
+        b->engine->init(n);
+    }
+
+    Rng rng(cfg.seed * 0x2545F4914F6CDD1DULL + index);
+    uint64_t attempts = 0, illegal = 0;
+    while (b->peg[2] != full && b->len < limit && attempts < limit * 4) {
+        int disk = 0, from = 0, to = 0;
+        if (cfg.mode == MODE_OPTIMAL) {
+            optimalMove(n, b->len + 1, disk, from, to);
+        } else if (cfg.mode == MODE_NOISY && rng.uniform() >= cfg.eps) {
+            nextOptimalMove(b->peg[0], b->peg[1], n, 2, disk, from, to);
+        } else {
+            int a = (int)(rng.next() % 6);
+            from = a / 2;
+            to = (from + 1 + a % 2) % 3;
+        }
+        attempts++;
+        if (!applyMove(*b, from, to)) illegal++;
+    }
+
+    st.games++;
+    st.moves += b->len;
+    st.illegal += illegal;
+    if (b->peg[2] == full) {
+        st.solved++;
+        st.excessMoves += b->len - optimal;
+        if (b->len == optimal) st.optimalGames++;
+    } else {
+        st.unsolvedDistance += distanceToPeg(b->peg[0], b->peg[1], n, 2);
+    }
+    if (b->engine) b->engine->~Game();
+}
+
+static SimStats runSim(const SimConfig &cfg, int threads, double &seconds) {
+    WorkStealingScheduler sched(threads);
+    std::vector<SimStats> perThread(threads);
+    std::vector<std::unique_ptr<Arena>> arenas;
+    for (int i = 0; i < threads; i++) arenas.emplace_back(new Arena());
+
+    auto t0 = std::chrono::steady_clock::now();
+    sched.run(cfg.games, 64, [&](int w, uint64_t b, uint64_t e) {
+        for (uint64_t i = b; i < e; i++) playGame(cfg, i, *arenas[w], perThread[w]);
+    });
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    SimStats total;
+    for (const SimStats &s : perThread) total.merge(s);
+    return total;
+}
+
+static void printStats(const SimConfig &cfg, const SimStats &s, double seconds) {
+    uint64_t attempts = s.moves + s.illegal;
+    printf("games            %llu  (%d disks, %s%s)\n", (unsigned long long)s.games, cfg.disks,
+           cfg.mode == MODE_RANDOM ? "random" : cfg.mode == MODE_NOISY ? "noisy" : "optimal",
+           cfg.engine ? ", Game engine" : "");
+    printf("solved           %llu  (%.2f%%), optimal %llu\n", (unsigned long long)s.solved,
+           s.games ? 100.0 * s.solved / s.games : 0.0, (unsigned long long)s.optimalGames);
+    printf("moves            %llu  (%.1f per game)\n", (unsigned long long)s.moves,
+           s.games ? (double)s.moves / s.games : 0.0);
+    printf("illegal rate     %.3f%%\n", attempts ? 100.0 * s.illegal / attempts : 0.0);
+    printf("excess moves     %.2f per solved game\n",
+           s.solved ? (double)s.excessMoves / s.solved : 0.0);
+    if (s.games > s.solved)
+        printf("distance left    %.2f per unsolved game\n",
+               (double)s.unsolvedDistance / (s.games - s.solved));
+    printf("time             %.3f s  (%.0f games/s, %.2f M moves/s)\n", seconds,
+           s.games / seconds, s.moves / seconds / 1e6);
+    if (cfg.engine) printMemoryReport(stdout, memoryReport());
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hanoi_sim [--games N] [--disks n] [--mode random|noisy|optimal] [--eps p]\n"
+            "                 [--max-moves M] [--threads T] [--seed S] [--engine] [--scaling]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    SimConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto val = [&]() -> const char* { if (i + 1 >= argc) usage(); return argv[++i]; };
+        if      (a == "--games")     cfg.games = strtoull(val(), nullptr, 10);
+        else if (a == "--disks")     cfg.disks = atoi(val());
+        else if (a == "--eps")       cfg.eps = atof(val());
+        else if (a == "--max-moves") cfg.maxMoves = strtoull(val(), nullptr, 10);
+        else if (a == "--threads")   cfg.threads = atoi(val());
+        else if (a == "--seed")      cfg.seed = strtoull(val(), nullptr, 10);
+        else if (a == "--engine")    cfg.engine = true;
+        else if (a == "--scaling")   cfg.scaling = true;
+        else if (a == "--mode") {
+            std::string m = val();
+            if      (m == "random")  cfg.mode = MODE_RANDOM;
+            else if (m == "noisy")   cfg.mode = MODE_NOISY;
+            else if (m == "optimal") cfg.mode = MODE_OPTIMAL;
+            else usage();
+        }
+        else usage();
+    }
+    if (cfg.disks < 1 || cfg.disks > 24) {
+        fprintf(stderr, "hanoi_sim: --disks must be 1..24\n");
+        return 2;
+    }
+    int maxThreads = cfg.threads > 0 ? cfg.threads : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1) maxThreads = 1;
+
+    if (!cfg.scaling) {
+        double sec;
+        SimStats s = runSim(cfg, maxThreads, sec);
+        printf("threads          %d\n", maxThreads);
+        printStats(cfg, s, sec);
+        return 0;
+    }
+
+    printf("%8s %12s %14s %9s %11s\n", "threads", "seconds", "games/s", "speedup", "efficiency");
+    double base = 0;
+    SimStats last;
+    double lastSec = 0;
+    for (int t = 1;; t = t * 2 < maxThreads ? t * 2 : maxThreads) {
+        double sec;
+        last = runSim(cfg, t, sec);
+        lastSec = sec;
+        if (t == 1) base = sec;
+        printf("%8d %12.3f %14.0f %8.2fx %10.1f%%\n", t, sec, last.games / sec,
+               base / sec, 100.0 * base / sec / t);
+        if (t == maxThreads) break;
+    }
+    printf("\n");
+    printStats(cfg, last, lastSec);
+    return 0;
+}
@@ -0,0 +1,447 @@
+// Streaming validator / replayer for move sequences.
+//
+//   hanoi_validate [--disks n] [--rules classic|cyclic|adjacent|EDGES] [--quiet] [file]
+//                                                      (stdin if no file)
+//
+// Accepts the move-log text format ("12. Disk 3: A -> C", also bare "A -> C"
+// or "AC" lines) and the packed binary HNMV format from movefile.h, detected
+// from the first bytes. Every move is checked with the rules Game::moveDisk
+// enforces under the chosen variant (variant.h; an HNMV header names its
+// own); the first violation is reported together with whether the final
+// position is solved and whether the sequence is the optimal one for those
+// rules.
+// A file argument is memory-mapped (mappedfile.h) and checked in place;
+// stdin and pipes are read in BLOCK-sized chunks.
+// Exit status: 0 valid and solved, 1 invalid or unsolved, 2 usage / I/O error.
+
+#include "mappedfile.h"
+#include "movefile.h"
+#include "solver.h"
+#include "variant.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+static const size_t BLOCK = 4 << 20;
+
+// Replays moves on three peg bitmasks (bit k-1 = disk k, top = lowest set bit).
+struct MoveChecker {
+    int      n;
+    MoveRules rules;
+    bool     classic;
+    uint64_t peg[3];
+    uint64_t moves;           // legal moves applied so far
+    uint64_t firstDeviation;  // first move that leaves the optimal path, 0 = none yet
+    bool     failed;
+    uint64_t failMove;
+    uint64_t failLine;
+    std::string failReason;
+    VariantSolver solver;     // optimal length under `rules`
+    VariantStream optimal;    // the optimal sequence, for variants
+
+    MoveChecker(int disks, MoveRules r) : n(disks), rules(r), classic(r == MoveRules::classic()),
+                                          moves(0), firstDeviation(0),
+                                          failed(false), failMove(0), failLine(0),
+                                          solver(r, classic ? 0 : disks), optimal(solver) {
+        peg[0] = fullTowerMask(n);
+        peg[1] = peg[2] = 0;
+    }
+
+    bool fail(uint64_t line, const std::string &why) {
+        failed = true;
+        failMove = moves + 1;
+        failLine = line;
+        failReason = why;
+        return false;
+    }
+
+    // diskHint / moveHint are 0 when the input does not state them. The
+    // checks are bare comparisons here; reject() works out which one failed
+    // and words it, keeping apply() small enough to inline into the loops.
+    bool apply(int from, int to, int diskHint, uint64_t moveHint, uint64_t line) {
+        uint64_t s = peg[from], d = peg[to];
+        uint64_t top = s & (0 - s);
+        if (from == to || !rules.allows(from, to) || s == 0 || (d != 0 && (d & (0 - d)) < top))
+            return reject(from, to, diskHint, moveHint, line);
+        int disk = __builtin_ctzll(top) + 1;
+        if ((diskHint && diskHint != disk) || (moveHint && moveHint != moves + 1))
+            return reject(from, to, diskHint, moveHint, line);
+        peg[from] = s ^ top;
+        peg[to]   = d ^ top;
+        moves++;
+        if (firstDeviation) return true;
+        if (classic) {
+            // still on the optimal path: move k is the optimal one iff it moves
+            // disk ctz(k)+1 (any larger disk then has a single legal move) and,
+            // for disk 1, goes round the way it cycles (A->C->B for odd n)
+            if (moves > optimalMoveCount(n) || disk != __builtin_ctzll(moves) + 1 ||
+                (disk == 1 && to != (from + (n & 1 ? 2 : 1)) % 3))
+                firstDeviation = moves;
+        } else if (!followsVariant(disk, from, to)) {
+            firstDeviation = moves;
+        }
+        return true;
+    }
+
+    bool reject(int from, int to, int diskHint, uint64_t moveHint, uint64_t line) {
+        uint64_t s = peg[from], d = peg[to], top = s & (0 - s);
+        if (from == to)
+            return fail(line, "source and destination are the same peg");
+        if (!rules.allows(from, to))
+            return fail(line, std::string(1, char('A' + from)) + " -> " + char('A' + to) +
+                              " is not allowed under the " + rules.name() + " rules");
+        if (s == 0)
+            return fail(line, std::string("peg ") + char('A' + from) + " is empty");
+        if (d != 0 && (d & (0 - d)) < top)
+            return fail(line, "cannot place a larger disk on a smaller one");
+        int disk = __builtin_ctzll(top) + 1;
+        if (diskHint && diskHint != disk)
+            return fail(line, "line names disk " + std::to_string(diskHint) +
+                              " but the top disk is " + std::to_string(disk));
+        return fail(line, "move is numbered " + std::to_string(moveHint) +
+                          ", expected " + std::to_string(moves + 1));
+    }
+
+    bool followsVariant(int disk, int from, int to) {
+        int od, of, ot;
+        return optimal.next(od, of, ot) && od == disk && of == from && ot == to;
+    }
+
+    uint64_t minimum() const { return classic ? optimalMoveCount(n) : solver.moveCount(); }
+
+    bool solved() const { return peg[2] == fullTowerMask(n); }
+};
+
+// ─── Text format ──────────────────────────────────────────────────────────────
+// Fast path for the exact move-log layout "k. Disk d: X -> Y"; everything else
+// goes through a small tokenizer.
+static inline bool isPeg(char c) { return c >= 'A' && c <= 'C'; }
+
+static bool parseLogLine(const char *b, const char *e, int &from, int &to,
+                         int &disk, uint64_t &moveNo) {
+    // tail: "d: X -> Y"
+    if (e - b < 16 || !isPeg(e[-1]) || !isPeg(e[-6]) ||
+        memcmp(e - 5, " -> ", 4) != 0 || e[-7] != ' ' || e[-8] != ':')
+        return false;
+    const char *q = e - 9;
+    int d = 0, mul = 1;
+    while (q >= b && *q >= '0' && *q <= '9') { d += (*q - '0') * mul; mul *= 10; q--; }
+    if (mul == 1 || q - b < 7 || memcmp(q - 6, ". Disk ", 7) != 0) return false;
+    uint64_t k = 0;
+    const char *p = b;
+    while (*p >= '0' && *p <= '9') k = k * 10 + (uint64_t)(*p++ - '0');
+    if (p != q - 6) return false;
+    from = e[-6] - 'A';
+    to = e[-1] - 'A';
+    disk = d;
+    moveNo = k;
+    return true;
+}
+
+// generic: the only A/B/C characters on a line are the two pegs; a number
+// followed by '.' is the move number and one followed by ':' is the disk
+static bool parseLooseLine(const char *b, const char *e, int &from, int &to,
+                           int &disk, uint64_t &moveNo) {
+    int pegs = 0;
+    uint64_t num = 0;
+    bool inNum = false;
+    disk = 0; moveNo = 0;
+    for (const char *p = b; p < e; p++) {
+        char c = *p;
+        if (c >= '0' && c <= '9') { num = num * 10 + (uint64_t)(c - '0'); inNum = true; continue; }
+        if (inNum) {
+            if (c == '.') moveNo = num;
+            else if (c == ':') disk = (int)num;
+            inNum = false;
+            num = 0;
+        }
+        if (isPeg(c)) {
+            if (pegs == 0) from = c - 'A';
+            else if (pegs == 1) to = c - 'A';
+            pegs++;
+        }
+    }
+    return pegs == 2;
+}
+
+// The next line as Game writes it, "k. Disk d: X -> Y\n", with the expected
+// move number k filled in and d, X and Y left as wildcards. The last digit
+// of k is kept apart in `last` and checked on its own, so bump() touches the
+// template bytes only on a carry (every tenth move) and the per-line SIMD
+// loads never wait on a fresh byte store.
+struct LineTemplate {
+    char     text[64];   // padded so 48-byte loads stay inside
+    int      digits;     // of k
+    char     last;       // last digit of k
+    uint64_t need;       // bit i set: line byte i must equal text[i]
+
+    LineTemplate() : digits(1), last('1') {
+        memset(text, 0, sizeof text);
+        text[0] = '1';
+        layout();
+    }
+
+    int length() const { return digits + 17; }   // with a one-digit disk
+    int diskAt() const { return digits + 7; }
+
+    void bump() {
+        if (last != '9') { last++; return; }
+        last = '0';
+        int i = digits - 2;
+        while (i >= 0 && text[i] == '9') text[i--] = '0';
+        if (i >= 0) { text[i]++; return; }
+        memset(text + 1, '0', (size_t)digits);   // 99..9 -> 100..0
+        text[0] = '1';
+        digits++;
+        layout();
+    }
+
+private:
+    void layout() {
+        memcpy(text + digits, ". Disk ?: ? -> ?\n", 17);
+        need = ((1ULL << length()) - 1) & ~(1ULL << (digits - 1)) & ~(1ULL << diskAt()) &
+               ~(1ULL << (digits + 10)) & ~(1ULL << (digits + 15));
+    }
+};
+
+// bit i set where a[i] == b[i], for i < 48; both must be readable for 48 bytes
+static inline uint64_t matchMask(const char *a, const char *b) {
+#if defined(__SSE2__) || defined(_M_X64)
+    uint64_t m = 0;
+    for (int v = 0; v < 3; v++) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + 16 * v));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + 16 * v));
+        m |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) << (16 * v);
+    }
+    return m;
+#else
+    uint64_t m = 0;
+    for (int i = 0; i < 48; i++) m |= (uint64_t)(a[i] == b[i]) << i;
+    return m;
+#endif
+}
+
+static const int FAST_SLACK = 64;   // bytes the fast path may read from a line start
+
+struct TextState {
+    LineTemplate next;
+    uint64_t     line = 0;
+};
+
+// Validates the lines in [p, end) and returns where the unconsumed partial
+// last line starts (end once everything is used; at eof the last line needs
+// no newline). A line in the exact layout Game writes, numbered as expected
+// and with a one-digit disk, takes the fast path: three 16-byte SIMD
+// compares against LineTemplate, then the three wildcard bytes are read
+// straight from their offsets — no number parsing, no newline search.
+// Anything else (two-digit disks, CRLF, comments, loose formats, mistakes)
+// goes through memchr and the parsers above, one line at a time.
+static const char* validateLines(const char *p, const char *end, bool eof,
+                                 MoveChecker &chk, TextState &st) {
+    while (!chk.failed) {
+        LineTemplate &t = st.next;
+        while (end - p >= FAST_SLACK) {
+            if ((matchMask(p, t.text) & t.need) != t.need || p[t.digits - 1] != t.last) break;
+            const char *q = p + t.diskAt();
+            unsigned d = (unsigned)(q[0] - '0'), from = (unsigned)(q[3] - 'A'), to = (unsigned)(q[8] - 'A');
+            if (d - 1 > 8 || from > 2 || to > 2) break;
+            st.line++;
+            if (!chk.apply((int)from, (int)to, (int)d, 0, st.line)) return p;
+            p += t.length();
+            t.bump();
+        }
+        if (p == end) return p;
+
+        const char *nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!nl) {
+            if (!eof) return p;
+            nl = end;   // last line without a newline
+        }
+        st.line++;
+        const char *e = nl;
+        if (e > p && e[-1] == '\r') e--;
+        if (e > p && *p != '#') {
+            int from = 0, to = 0, disk = 0;
+            uint64_t k = 0;
+            if (!parseLogLine(p, e, from, to, disk, k) &&
+                !parseLooseLine(p, e, from, to, disk, k)) {
+                chk.fail(st.line, "cannot parse line");
+                return p;
+            }
+            if (!chk.apply(from, to, disk, k, st.line)) return p;
+            st.next.bump();
+        }
+        p = nl < end ? nl + 1 : end;
+    }
+    return p;
+}
+
+static void validateText(const char *data, size_t size, MoveChecker &chk) {
+    TextState st;
+    validateLines(data, data + size, true, chk, st);
+}
+
+// stdin / pipes: blocks of BLOCK bytes, the partial last line carried over
+static void validateTextStream(FILE *in, std::vector<char> &buf, size_t have, MoveChecker &chk) {
+    TextState st;
+    size_t carry = have;   // bytes already in buf (the sniffed prefix)
+    bool eof = false;
+    while (!chk.failed && !eof) {
+        size_t got = fread(buf.data() + carry, 1, buf.size() - carry, in);
+        eof = got < buf.size() - carry;
+        const char *end = buf.data() + carry + got;
+        const char *p = validateLines(buf.data(), end, eof, chk, st);
+        carry = (size_t)(end - p);
+        memmove(buf.data(), p, carry);
+        if (carry == buf.size()) buf.resize(buf.size() * 2);   // absurdly long line
+    }
+}
+
+// ─── Binary format ────────────────────────────────────────────────────────────
+// packed moves in [p, p + bytes); done counts moves across calls
+static void validatePacked(const uint8_t *p, size_t bytes, uint64_t &done, uint64_t count,
+                           MoveChecker &chk) {
+    for (size_t i = 0; i < bytes && done < count; i++) {
+        uint8_t lo = p[i] & 15, hi = p[i] >> 4;
+        if (packedFrom(lo) > 2 || packedTo(lo) > 2) { chk.fail(0, "bad peg code"); return; }
+        if (!chk.apply(packedFrom(lo), packedTo(lo), 0, 0, 0)) return;
+        if (++done == count) return;
+        if (packedFrom(hi) > 2 || packedTo(hi) > 2) { chk.fail(0, "bad peg code"); return; }
+        if (!chk.apply(packedFrom(hi), packedTo(hi), 0, 0, 0)) return;
+        done++;
+    }
+}
+
+static void validateBinary(const uint8_t *data, size_t size, MoveChecker &chk, uint64_t count) {
+    uint64_t done = 0;
+    validatePacked(data + sizeof(MoveFileHeader), size - sizeof(MoveFileHeader), done, count, chk);
+    if (!chk.failed && done < count)
+        chk.fail(0, "file ends after " + std::to_string(done) + " of " + std::to_string(count) + " moves");
+}
+
+static void validateBinaryStream(FILE *in, std::vector<char> &buf, size_t have, MoveChecker &chk,
+                                 uint64_t count) {
+    uint64_t done = 0;
+    size_t pos = sizeof(MoveFileHeader);
+    while (done < count && !chk.failed) {
+        if (pos >= have) {
+            have = fread(buf.data(), 1, buf.size(), in);
+            pos = 0;
+            if (have == 0) {
+                chk.fail(0, "file ends after " + std::to_string(done) + " of " +
+                            std::to_string(count) + " moves");
+                break;
+            }
+        }
+        validatePacked((const uint8_t*)buf.data() + pos, have - pos, done, count, chk);
+        pos = have;
+    }
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hanoi_validate [--disks n] [--rules classic|cyclic|adjacent|EDGES] [--quiet] [file]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    int disks = 0;
+    bool quiet = false, rulesGiven = false;
+    MoveRules rules = MoveRules::classic();
+    const char *path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--disks") && i + 1 < argc) disks = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rules") && i + 1 < argc) {
+            if (!parseMoveRules(argv[++i], rules)) usage();
+            rulesGiven = true;
+        }
+        else if (!strcmp(argv[i], "--quiet")) quiet = true;
+        else if (argv[i][0] == '-' && argv[i][1]) usage();
+        else if (!path) path = argv[i];
+        else usage();
+    }
+
+    // a regular file is mapped and validated in place; stdin and pipes stream
+    MappedFile map;
+    const bool mapped = path && strcmp(path, "-") != 0 && map.open(path);
+    FILE *in = stdin;
+    std::vector<char> buf;
+    const uint8_t *head;
+    size_t have;
+    if (mapped) {
+        map.adviseSequential();
+        head = map.data();
+        have = (size_t)map.size();
+    } else {
+        if (path && strcmp(path, "-") != 0) {
+            in = fopen(path, "rb");
+            if (!in) { perror(path); return 2; }
+        }
+        setvbuf(in, nullptr, _IONBF, 0);   // we already read in large blocks
+        buf.resize(BLOCK);
+        have = fread(buf.data(), 1, sizeof(MoveFileHeader), in);
+        head = (const uint8_t*)buf.data();
+    }
+    bool binary = isMoveFileHeader(head, have);
+
+    uint64_t count = 0;
+    if (binary) {
+        MoveFileHeader h;
+        memcpy(&h, head, sizeof h);
+        if (h.version != MOVEFILE_VERSION) {
+            fprintf(stderr, "hanoi_validate: unsupported move file version %d\n", h.version);
+            return 2;
+        }
+        if (disks && disks != h.numDisks)
+            fprintf(stderr, "hanoi_validate: file header says %d disks, using it\n", h.numDisks);
+        disks = h.numDisks;
+        count = h.moveCount;
+        MoveRules fileRules = {h.rules ? h.rules : MoveRules::classic().mask};
+        if (rulesGiven && rules != fileRules)
+            fprintf(stderr, "hanoi_validate: file header says %s rules, using them\n", fileRules.name());
+        rules = fileRules;
+    }
+    if (disks < 1 || disks > 64) {
+        fprintf(stderr, "hanoi_validate: need --disks 1..64 for text input\n");
+        return 2;
+    }
+    if (rules != MoveRules::classic() && disks > VariantSolver::MAX_DISKS) {
+        fprintf(stderr, "hanoi_validate: at most %d disks under %s rules\n",
+                VariantSolver::MAX_DISKS, rules.name());
+        return 2;
+    }
+
+    MoveChecker chk(disks, rules);
+    if (mapped) {
+        if (binary) validateBinary(head, have, chk, count);
+        else        validateText((const char*)head, have, chk);
+    } else {
+        if (binary) validateBinaryStream(in, buf, have, chk, count);
+        else        validateTextStream(in, buf, have, chk);
+        if (in != stdin) fclose(in);
+    }
+
+    bool solved = !chk.failed && chk.solved();
+    bool optimal = solved && chk.moves == chk.minimum();
+    if (!quiet) {
+        printf("format      %s\n", binary ? "binary (HNMV)" : "text");
+        printf("disks       %d\n", disks);
+        printf("rules       %s\n", rules.name());
+        printf("moves       %llu legal\n", (unsigned long long)chk.moves);
+        if (chk.failed) {
+            printf("INVALID     move %llu", (unsigned long long)chk.failMove);
+            if (chk.failLine) printf(" (line %llu)", (unsigned long long)chk.failLine);
+            printf(": %s\n", chk.failReason.c_str());
+        }
+        printf("solved      %s\n", solved ? "yes" : "no");
+        printf("optimal     %s", optimal ? "yes" : "no");
+        if (!optimal && chk.firstDeviation)
+            printf("  (leaves the optimal path at move %llu)", (unsigned long long)chk.firstDeviation);
+        printf("  [minimum %llu]\n", (unsigned long long)chk.minimum());
+    }
+    return solved ? 0 : 1;
+}
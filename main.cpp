@@ -1,10 +1,31 @@
 #include <QApplication>
+#include <cstdio>
 #include "mainwindow.h"
+#include "startup.h"
+#include "trace.h"
 
 int main(int argc, char *argv[]) {
+    startupMark("main");
     QApplication app(argc, argv);
     app.setStyle("Fusion");
+    startupMark("QApplication");
+
+    // --trace <file.json>: dump trace zones on exit (needs -DHANOI_TRACE=ON)
+    QString tracePath;
+    QStringList args = app.arguments();
+    int ti = args.indexOf("--trace");
+    if (ti >= 0 && ti + 1 < args.size()) tracePath = args[ti + 1];
+    if (!tracePath.isEmpty() && !traceEnabled())
+        fprintf(stderr, "TowerOfHanoi: built without HANOI_TRACE, --trace ignored\n");
+    // --startup-times: print the cold-start phases once the board has painted
+    if (args.contains("--startup-times")) startupReportTo(stderr);
+
     MainWindow w;
+    startupMark("MainWindow");
     w.show();
-    return app.exec();
+    startupMark("show");
+    int rc = app.exec();
+    if (!tracePath.isEmpty() && traceEnabled() && !traceWriteChrome(qPrintable(tracePath)))
+        fprintf(stderr, "TowerOfHanoi: cannot write %s\n", qPrintable(tracePath));
+    return rc;
 }
@@ -1,4 +1,7 @@
 #include "mainwindow.h"
+#include "trace.h"
+#include "solver.h"
+#include "startup.h"
 #include <QScrollArea>
 #include <QStackedWidget>
 #include <QFrame>
@@ -6,52 +9,73 @@
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QGraphicsTextItem>
+#include <QPainterPath>
 #include <QPainter>
 #include <QPen>
 #include <QBrush>
 #include <QFont>
 #include <QMouseEvent>
+#include <QWheelEvent>
 #include <QEvent>
+#include <QCloseEvent>
+#include <QStandardPaths>
+#include <QDir>
+#include <QShortcut>
+#include <QKeySequence>
 #include <cmath>
 #include <stack>
 #include <vector>
 #include <algorithm>
 
-static const int TX[3] = {125, 375, 625};
-
-QColor MainWindow::diskColor(int sz) {
-    static QColor p[] = {
-        QColor("#FF6B6B"),QColor("#FF922B"),QColor("#FCC419"),
-        QColor("#51CF66"),QColor("#20C997"),QColor("#339AF0"),
-        QColor("#845EF7"),QColor("#F06595")
-    };
-    return p[(sz-1)%8];
-}
-int MainWindow::towerX(int i)  { return TX[i]; }
-int MainWindow::baseY()        { return SCENE_H - 45; }
-int MainWindow::diskW(int sz)  {
-    float r = (float)sz / game.numDisks;
-    return MIN_DISK_W + (int)((MAX_DISK_W-MIN_DISK_W)*r);
-}
-int MainWindow::towerAtX(int x){
-    for(int i=0;i<3;i++) if(std::abs(x-TX[i])<130) return i;
-    return -1;
-}
+// geometry and palette live in BoardPainter, shared with the painter board,
+// hanoi_render and the dashboard
+QColor MainWindow::diskColor(int sz) { return BoardPainter::diskColor(sz,game.numDisks); }
+int MainWindow::towerX(int i)        { return BoardPainter::towerX(i); }
+int MainWindow::baseY()              { return BoardPainter::baseY(); }
+int MainWindow::diskH()              { return BoardPainter::diskH(game.numDisks); }
+int MainWindow::diskThick()          { return BoardPainter::diskThick(game.numDisks); }
+int MainWindow::diskW(int sz)        { return BoardPainter::diskW(sz,game.numDisks); }
+int MainWindow::towerAtX(int x)      { return BoardPainter::towerAtX(x); }
 
 // ─────────────────────────────────────────────────────────────────────────────
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
     numDisks(3), selectedTower(-1),
-    dragging(false), dragFromTower(-1), dragGhost(nullptr),
-    animating(false), animFrom(-1), animTo(-1), animDiskSz(0),
-    animProgress(0), animItem(nullptr),
-    animSX(0),animSY(0),animEX(0),animEY(0),animArcY(0),
-    elapsedSeconds(0), gameRunning(false)
+    dragging(false), dragFromTower(-1), dragDiskSz(0), dragGhost(nullptr),
+    animating(false), animStep(ANIM_STEP_NORMAL), animEnteredMs(-1), zoom(1.0),
+    painterMode(false),
+    elapsedSeconds(0), gameRunning(false), session(nullptr), probe(nullptr), hud(nullptr), stateGraph(nullptr),
+    aboutDlg(nullptr), firstFramePending(true)
 {
+    TRACE_ZONE("MainWindow::MainWindow");
     setWindowTitle("Tower of Hanoi — DSA Project");
     setMinimumSize(1080, 660);
+    setStyleSheet("QMainWindow,QWidget{background:#181825;}");
 
+    // One sheet for the whole panel, parsed once, instead of one per widget.
+    // Scoped to the central widget so dialogs parented to the window keep
+    // their own look.
     QWidget *central = new QWidget(this);
+    central->setStyleSheet(
+        "QGraphicsView{background:#12121F;border:2px solid #313244;border-radius:10px;}"
+        "QGraphicsView QWidget{background:#12121F;}"
+        "QLabel#labelHelp{color:#A6ADC8;background:#1E1E2E;font-size:11px;border-radius:6px;padding:5px;}"
+        "QLabel#labelStatus{font-size:13px;font-weight:bold;color:#CDD6F4;"
+        "background:#313244;border-radius:8px;padding:8px;}"
+        "QGroupBox{font-weight:bold;color:#89B4FA;border:1px solid #313244;border-radius:6px;"
+        "margin-top:8px;padding:6px;}"
+        "QLabel#labelMoveCount{font-size:14px;color:#89B4FA;font-weight:bold;}"
+        "QLabel#labelTimer{font-size:14px;color:#A6E3A1;font-weight:bold;}"
+        "QLabel#labelDisks{color:#CDD6F4;}"
+        "QComboBox{background:#313244;color:#CDD6F4;padding:4px;border-radius:4px;}"
+        "QPushButton{color:white;font-weight:bold;padding:10px;border-radius:7px;font-size:13px;}"
+        "QPushButton:pressed{padding:9px 11px;}"
+        "QPushButton#btnAutoSolve{background:#7C3AED;}"
+        "QPushButton#btnUndo{background:#D97706;}"
+        "QPushButton#btnReset{background:#059669;}"
+        "QPushButton#btnAbout{background:#1e6ba1;}"
+        "QListWidget{background:#12121F;color:#CDD6F4;font-size:12px;border:none;border-radius:4px;}"
+        "QListWidget::item{padding:2px;}");
     setCentralWidget(central);
     QHBoxLayout *root = new QHBoxLayout(central);
     root->setSpacing(14);
@@ -61,30 +85,33 @@ MainWindow::MainWindow(QWidget *parent)
     leftL->setSpacing(8);
 
     scene = new QGraphicsScene(0, 0, SCENE_W, SCENE_H, this);
-    view  = new QGraphicsView(scene, this);
+    view  = new SceneView(scene, this, this, &probe);
     view->setRenderHint(QPainter::Antialiasing);
     view->setFixedSize(SCENE_W+2, SCENE_H+2);
-    view->setStyleSheet("background:#12121F;border:2px solid #313244;border-radius:10px;");
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->installEventFilter(this);
+    view->viewport()->installEventFilter(this);   // first-frame stamp only, removed after
 
     labelHelp = new QLabel(
         "  HOW TO PLAY:  "
         "CLICK a tower to select its top disk  →  CLICK another tower to place it  |  "
         "OR  DRAG a disk directly to another tower");
     labelHelp->setAlignment(Qt::AlignCenter);
-    labelHelp->setStyleSheet(
-        "color:#A6ADC8;background:#1E1E2E;font-size:11px;border-radius:6px;padding:5px;");
+    labelHelp->setObjectName("labelHelp");
 
     labelStatus = new QLabel("Choose number of disks, then press  Reset / New Game");
     labelStatus->setAlignment(Qt::AlignCenter);
     labelStatus->setWordWrap(true);
-    labelStatus->setStyleSheet(
-        "font-size:13px;font-weight:bold;color:#CDD6F4;"
-        "background:#313244;border-radius:8px;padding:8px;");
-
-    leftL->addWidget(view);
+    labelStatus->setObjectName("labelStatus");
+
+    board = new BoardWidget(this, this);
+    board->installEventFilter(this);
+    boardStack = new QStackedWidget;
+    boardStack->setFixedSize(SCENE_W+2, SCENE_H+2);
+    boardStack->addWidget(view);
+    boardStack->addWidget(board);
+    leftL->addWidget(boardStack);
     leftL->addWidget(labelHelp);
     leftL->addWidget(labelStatus);
 
@@ -92,58 +119,40 @@ MainWindow::MainWindow(QWidget *parent)
     QVBoxLayout *rightL = new QVBoxLayout;
     rightL->setSpacing(10);
 
-    auto mkGroup = [](const QString &t) {
-        QGroupBox *g = new QGroupBox(t);
-        g->setStyleSheet(
-            "QGroupBox{font-weight:bold;color:#89B4FA;"
-            "border:1px solid #313244;border-radius:6px;"
-            "margin-top:8px;padding:6px;}");
-        return g;
-    };
-
-    QGroupBox *gbInfo = mkGroup("Game Info");
+    QGroupBox *gbInfo = new QGroupBox("Game Info");
     QVBoxLayout *infoL = new QVBoxLayout(gbInfo);
     labelMoveCount = new QLabel("Moves: 0");
     labelTimer     = new QLabel("Time:  00:00");
-    labelMoveCount->setStyleSheet("font-size:14px;color:#89B4FA;font-weight:bold;");
-    labelTimer    ->setStyleSheet("font-size:14px;color:#A6E3A1;font-weight:bold;");
+    labelMoveCount->setObjectName("labelMoveCount");
+    labelTimer    ->setObjectName("labelTimer");
     infoL->addWidget(labelMoveCount);
     infoL->addWidget(labelTimer);
 
-    QGroupBox *gbSetup = mkGroup("Setup");
+    QGroupBox *gbSetup = new QGroupBox("Setup");
     QHBoxLayout *setupL = new QHBoxLayout(gbSetup);
     QLabel *lbD = new QLabel("Number of Disks:");
-    lbD->setStyleSheet("color:#CDD6F4;");
+    lbD->setObjectName("labelDisks");
     comboDiskCount = new QComboBox;
-    for(int i=2;i<=8;i++) comboDiskCount->addItem(QString::number(i));
+    for(int i=2;i<=MAX_UI_DISKS;i++) comboDiskCount->addItem(QString::number(i));
     comboDiskCount->setCurrentIndex(1);
-    comboDiskCount->setStyleSheet(
-        "background:#313244;color:#CDD6F4;padding:4px;border-radius:4px;");
     setupL->addWidget(lbD);
     setupL->addWidget(comboDiskCount);
 
-    auto mkBtn=[](const QString &txt,const QString &bg){
+    auto mkBtn=[](const QString &txt,const char *name){
         QPushButton *b=new QPushButton(txt);
         b->setCursor(Qt::PointingHandCursor);
-        b->setStyleSheet(QString(
-                             "QPushButton{background:%1;color:white;font-weight:bold;"
-                             "padding:10px;border-radius:7px;font-size:13px;}"
-                             "QPushButton:pressed{padding:9px 11px;}").arg(bg));
+        b->setObjectName(name);   // colour comes from the panel sheet
         return b;
     };
-    btnAutoSolve = mkBtn("⚡  Auto Solve (Queue)","#7C3AED");
-    btnUndo      = mkBtn("↩  Undo Last Move",     "#D97706");
-    btnReset     = mkBtn("🔄  Reset / New Game",  "#059669");
-    btnAbout     = mkBtn("📖  About / DSA Info",   "#1e6ba1");
+    btnAutoSolve = mkBtn("⚡  Auto Solve (Queue)","btnAutoSolve");
+    btnUndo      = mkBtn("↩  Undo Last Move",     "btnUndo");
+    btnReset     = mkBtn("🔄  Reset / New Game",  "btnReset");
+    btnAbout     = mkBtn("📖  About / DSA Info",   "btnAbout");
 
-    QGroupBox *gbLog = mkGroup("Move History (Queue log)");
+    QGroupBox *gbLog = new QGroupBox("Move History (Queue log)");
     QVBoxLayout *logL = new QVBoxLayout(gbLog);
     moveLogList = new QListWidget;
     moveLogList->setMinimumHeight(200);
-    moveLogList->setStyleSheet(
-        "QListWidget{background:#12121F;color:#CDD6F4;"
-        "font-size:12px;border:none;border-radius:4px;}"
-        "QListWidget::item{padding:2px;}");
     logL->addWidget(moveLogList);
 
     rightL->addWidget(gbInfo);
@@ -157,12 +166,13 @@ MainWindow::MainWindow(QWidget *parent)
 
     root->addLayout(leftL);
     root->addLayout(rightL);
-    setStyleSheet("QMainWindow,QWidget{background:#181825;}");
+    startupMark("widgets built");
 
     // Animation timer — fires 60fps
     animTimer = new QTimer(this);
     animTimer->setInterval(16);
     connect(animTimer, &QTimer::timeout, this, &MainWindow::onAnimStep);
+    inputClock.start();
 
     autoSolveTimer = new QTimer(this);
     autoSolveTimer->setInterval(700);
@@ -177,66 +187,157 @@ MainWindow::MainWindow(QWidget *parent)
     connect(btnReset,     &QPushButton::clicked, this, &MainWindow::onResetClicked);
     connect(btnAbout,     &QPushButton::clicked, this, &MainWindow::onAboutClicked);
 
+    // Performance HUD overlay — F3 toggles it
+    hud = new PerfHud(view->viewport(), &hudProbe, scene);
+    QShortcut *hudKey = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(hudKey, &QShortcut::activated, this, &MainWindow::toggleHud);
+    // F4 switches between the QGraphicsScene and the QPainter board
+    QShortcut *rendererKey = new QShortcut(QKeySequence(Qt::Key_F4), this);
+    connect(rendererKey, &QShortcut::activated, this, [this]{ setPainterBoard(!painterMode); });
+    // F6 opens the live state graph next to the board
+    QShortcut *graphKey = new QShortcut(QKeySequence(Qt::Key_F6), this);
+    graphKey->setContext(Qt::ApplicationShortcut);
+    connect(graphKey, &QShortcut::activated, this, &MainWindow::toggleStateGraph);
+
     game.init(3);
     redraw();
+
+    // ── Session restore ──────────────────────────────────────────────────────
+    QString dataDir=QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    session=new SessionStore(dataDir.toStdString());
+    if(session->restore(game,elapsedSeconds)){
+        numDisks=game.numDisks;
+        if(numDisks>=2&&numDisks<=MAX_UI_DISKS) comboDiskCount->setCurrentIndex(numDisks-2);
+        labelTimer->setText(QString("Time:  %1:%2")
+                                .arg(elapsedSeconds/60,2,10,QChar('0'))
+                                .arg(elapsedSeconds%60,2,10,QChar('0')));
+        redraw();
+        updateMoveLog();
+        updateStatus(QString("Previous session restored — %1 moves so far.").arg(game.moveCount));
+    } else {
+        session->snapshot(game,0);
+    }
+    startupMark("session restored");
+}
+
+MainWindow::~MainWindow() { delete session; }
+
+void MainWindow::toggleHud(){
+    bool on=!hud->isVisible();
+    if(on){ hudProbe.clear(); probe=&hudProbe; }
+    else if(probe==&hudProbe) probe=nullptr;
+    hud->setVisible(on);
+}
+
+void MainWindow::toggleStateGraph(){
+    if(!stateGraph){
+        stateGraph=new StateGraphView(this);
+        stateGraph->setWindowFlag(Qt::Tool);
+        stateGraph->resize(520,480);
+    }
+    if(stateGraph->isVisible()){ stateGraph->hide(); return; }
+    stateGraph->show();   // first: syncStateGraph skips a hidden view
+    syncStateGraph();
 }
 
-MainWindow::~MainWindow() {}
+// O(n); single moves go through StateGraphView::applyMove instead
+void MainWindow::syncStateGraph(){
+    if(!stateGraph||!stateGraph->isVisible()) return;
+    uint64_t peg[3]={game.towerA.mask(),game.towerB.mask(),game.towerC.mask()};
+    stateGraph->setPosition(game.numDisks,peg);
+}
+
+void MainWindow::closeEvent(QCloseEvent *event){
+    session->flush();
+    QMainWindow::closeEvent(event);
+}
 
 // ─── Event filter ─────────────────────────────────────────────────────────────
 bool MainWindow::eventFilter(QObject *obj, QEvent *ev) {
-    if(obj != view) return QMainWindow::eventFilter(obj,ev);
-    if(animating)   return true;  // block input while animating
+    if(firstFramePending && ev->type()==QEvent::Paint && (obj==view->viewport()||obj==board)){
+        // stamp once this paint has gone out, then warm the About dialog while idle
+        firstFramePending=false;
+        view->viewport()->removeEventFilter(this);
+        QTimer::singleShot(0, this, []{ startupFirstFrame(); });
+        QTimer::singleShot(ABOUT_PREBUILD_MS, this, &MainWindow::prebuildAboutDialog);
+    }
+    if(obj != view && obj != board) return QMainWindow::eventFilter(obj,ev);
+    // input during an animation is queued, not dropped (see requestMove)
+
+    // the view zooms in SceneView::wheelEvent; the painter board is not zoomable
+    if(ev->type()==QEvent::Wheel && obj==board) return true;
 
     if(ev->type()==QEvent::MouseButtonPress){
         QMouseEvent *me = static_cast<QMouseEvent*>(ev);
-        handleMousePress(view->mapToScene(me->pos()));
+        handleMousePress(obj==board ? me->position() : view->mapToScene(me->pos()));
         return true;
     }
     if(ev->type()==QEvent::MouseMove){
         QMouseEvent *me = static_cast<QMouseEvent*>(ev);
-        handleMouseMove(view->mapToScene(me->pos()));
+        handleMouseMove(obj==board ? me->position() : view->mapToScene(me->pos()));
         return true;
     }
     if(ev->type()==QEvent::MouseButtonRelease){
         QMouseEvent *me = static_cast<QMouseEvent*>(ev);
-        handleMouseRelease(view->mapToScene(me->pos()));
+        handleMouseRelease(obj==board ? me->position() : view->mapToScene(me->pos()));
         return true;
     }
     return QMainWindow::eventFilter(obj,ev);
 }
 
+// zoom under the cursor; redraw picks the level of detail for it
+void MainWindow::zoomAt(int wheelDelta) {
+    double z=zoom*std::pow(1.25,wheelDelta/120.0);
+    z=std::min(ZOOM_MAX,std::max(1.0,z));
+    if(z==zoom) return;
+    view->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    view->scale(z/zoom,z/zoom);
+    zoom=z;
+    redraw();
+}
+
 // ─── Mouse ────────────────────────────────────────────────────────────────────
 void MainWindow::handleMousePress(QPointF sp) {
     if(autoSolveTimer->isActive()) return;
+    if(animating) animStep=ANIM_STEP_FAST;   // new input: hurry the disk in flight to its landing spot
     int tIdx = towerAtX((int)sp.x());
     if(tIdx==-1) return;
 
-    QString names[3]={"A","B","C"};
-    Tower *t = game.getTower(names[tIdx].toStdString());
-
-    // Start drag only if tower has disks
-    if(t && !t->isEmpty()){
+    // Start drag only if tower has disks (once pending moves have landed)
+    int sz=predictedTop(tIdx);
+    if(sz>0){
         dragging=true;
         dragFromTower=tIdx;
-        int sz=t->top();
-        int dw=diskW(sz);
-        QColor col=diskColor(sz);
-        // ghost follows cursor
-        dragGhost=scene->addRect(-dw/2,-(DISK_H-4)/2,dw,DISK_H-4,
-                                   QPen(col.lighter(140),2),
-                                   QBrush(QColor(col.red(),col.green(),col.blue(),150)));
-        dragGhost->setPos(sp);
-        dragGhost->setZValue(200);
+        dragDiskSz=sz;
+        dragPos=sp;
+        makeDragGhost();
     }
 
     // Also run click-select logic
     handleTowerClick(tIdx);
 }
 
+// ghost follows cursor; recreated whenever the scene is rebuilt mid-drag
+void MainWindow::makeDragGhost(){
+    if(painterMode){ board->updateDisk(dragPos,dragPos,dragDiskSz); return; }
+    int dw=diskW(dragDiskSz);
+    QColor col=diskColor(dragDiskSz);
+    int th=diskThick();
+    dragGhost=scene->addRect(-dw/2,-th/2,dw,th,
+                               QPen(col.lighter(140),2),
+                               QBrush(QColor(col.red(),col.green(),col.blue(),150)));
+    dragGhost->setPos(dragPos);
+    dragGhost->setZValue(200);
+}
+
 void MainWindow::handleMouseMove(QPointF sp){
+    QPointF old=dragPos;
+    dragPos=sp;
     if(dragging && dragGhost)
         dragGhost->setPos(sp);
+    else if(dragging && painterMode)
+        board->updateDisk(old,sp,dragDiskSz);
 }
 
 void MainWindow::handleMouseRelease(QPointF sp){
@@ -248,12 +349,13 @@ void MainWindow::handleMouseRelease(QPointF sp){
         scene->removeItem(dragGhost);
         dragGhost=nullptr;
     }
+    if(painterMode) board->updateDisk(dragPos,dragPos,dragDiskSz);
 
     int toTower=towerAtX((int)sp.x());
     if(toTower!=-1 && toTower!=dragFromTower){
         // drag completed to different tower
         selectedTower=-1;
-        doMove(dragFromTower, toTower);
+        requestMove(dragFromTower, toTower);
     }
     dragFromTower=-1;
 }
@@ -264,169 +366,346 @@ void MainWindow::handleTowerClick(int tIdx){
     QString names[3]={"A","B","C"};
 
     if(selectedTower==-1){
-        Tower *t=game.getTower(names[tIdx].toStdString());
-        if(!t||t->isEmpty()){
+        if(predictedTop(tIdx)<0){
             updateStatus("That tower is empty! Click a tower that has disks.");
             return;
         }
         selectedTower=tIdx;
-        redraw();
+        if(!animating) redraw();   // otherwise the highlight shows once the disk lands
         updateStatus(QString("Tower %1 selected — now click the destination tower  (click same tower to cancel)").arg(names[tIdx]));
     } else {
         if(tIdx==selectedTower){
-            selectedTower=-1; redraw();
+            selectedTower=-1;
+            if(!animating) redraw();
             updateStatus("Selection cancelled.");
             return;
         }
         int from=selectedTower;
         selectedTower=-1;
-        doMove(from,tIdx);
+        requestMove(from,tIdx);
     }
 }
 
-// ─── Move + Animation ─────────────────────────────────────────────────────────
-void MainWindow::doMove(int from, int to){
+// ─── Move queue ───────────────────────────────────────────────────────────────
+// Board as it will be once the disk in flight and every queued move have landed
+void MainWindow::predictedPegs(uint64_t peg[3], bool withQueue){
+    Tower *t[3]={&game.towerA,&game.towerB,&game.towerC};
+    for(int i=0;i<3;i++){
+        peg[i]=t[i]->mask();
+    }
+    auto apply=[&](int f,int to){uint64_t low=peg[f]&(~peg[f]+1);peg[f]^=low;peg[to]|=low;};
+    for(const Flight &f:flights) apply(f.from,f.to);
+    if(withQueue)
+        for(const QueuedMove &q:moveQueue) apply(q.from,q.to);
+}
+
+int MainWindow::predictedTop(int idx){
+    uint64_t peg[3];
+    predictedPegs(peg);
+    if(!peg[idx]) return -1;
+    int sz=1;
+    while(!(peg[idx]&(1ULL<<(sz-1)))) sz++;
+    return sz;
+}
+
+void MainWindow::requestMove(int from, int to){
+    if(!animating && moveQueue.empty()){
+        animEnteredMs=-1;
+        doMove(from,to);
+        return;
+    }
     QString names[3]={"A","B","C"};
+    uint64_t peg[3];
+    predictedPegs(peg);
+    uint64_t src=peg[from]&(~peg[from]+1), dst=peg[to]&(~peg[to]+1);
+    if(!src){
+        updateStatus(QString("Rejected — tower %1 will be empty by then.").arg(names[from]));
+        return;
+    }
+    if(dst && dst<src){
+        updateStatus("Rejected — that would put a larger disk on a smaller one.");
+        return;
+    }
+    moveQueue.push_back({from,to,inputClock.elapsed()});
+    animStep=ANIM_STEP_FAST;
+
+    // latency budget: rest of the current arc plus every queued arc, all fast-forwarded
+    int perArc=(int)std::ceil(1.0f/ANIM_STEP_FAST);
+    int frames=(int)std::ceil((1.0f-flights.back().progress)/ANIM_STEP_FAST)+(int)moveQueue.size()*perArc;
+    updateStatus(QString("Queued %1 → %2  (%3 pending, lands in ~%4 ms)")
+                     .arg(names[from],names[to]).arg(moveQueue.size()).arg(frames*animTimer->interval()));
+}
 
-    Tower *src=game.getTower(names[from].toStdString());
-    Tower *dst=game.getTower(names[to].toStdString());
+void MainWindow::clearMoveQueue(){
+    moveQueue.clear();
+    animEnteredMs=-1;
+    animStep=ANIM_STEP_NORMAL;
+}
+
+// ─── Move + Animation ─────────────────────────────────────────────────────────
+void MainWindow::doMove(int from, int to){
+    ScopedProbe sp(probe, PerfProbe::DO_MOVE);
+    TRACE_ZONE("MainWindow::doMove");
 
-    if(!src||src->isEmpty()){
+    // validate against the board as it will be once the disks in the air land
+    uint64_t peg[3];
+    predictedPegs(peg,false);
+    if(!peg[from]){
         updateStatus("That tower is empty!"); return;
     }
-    int diskSz=src->top();
-    if(!dst->isEmpty()&&dst->top()<diskSz){
+    Flight f=planFlight(from,to,peg);
+    uint64_t dst=peg[to]&(~peg[to]+1);
+    if(dst && dst<(1ULL<<(f.disk-1))){
         updateStatus("Invalid! Cannot place a larger disk on a smaller one.");
         redraw(); return;
     }
 
     if(!gameRunning){ gameRunning=true; clockTimer->start(); }
 
-    // --- Setup animation ---
-    int srcCount=(int)src->disks.size();
-    int dstCount=(int)dst->disks.size();
-
-    animFrom    = from;
-    animTo      = to;
-    animDiskSz  = diskSz;
-    animProgress= 0.0f;
-    animSX      = towerX(from);
-    animSY      = baseY() - srcCount * DISK_H;       // top disk Y on source
-    animEX      = towerX(to);
-    animEY      = baseY() - (dstCount+1) * DISK_H;   // landing Y on dest
-    animArcY    = 55.0f;                              // arc peak Y
-
-    // Create the moving disk rectangle
-    int dw = diskW(diskSz);
-    QColor col = diskColor(diskSz);
-    animItem = scene->addRect(-dw/2, -(DISK_H-4)/2, dw, DISK_H-4,
-                              QPen(col.darker(140),2), QBrush(col));
-    animItem->setPos(animSX, animSY);
-    animItem->setZValue(150);
-
+    flights.push_back(f);
     animating = true;
-    animTimer->start();
+    animStep  = ANIM_STEP_NORMAL;
+    if(!animTimer->isActive()) animTimer->start();
 
-    // Hide the disk on source while it animates by redrawing
-    // We temporarily pop it from the game for visual only - NO, just redraw towers/disks
-    // hiding top disk of source: easiest = just redraw without changing game state
-    // The animItem visually replaces it. Redraw scene (clear disks except anim item)
-    scene->clear();
-    animItem = scene->addRect(-dw/2, -(DISK_H-4)/2, dw, DISK_H-4,
-                              QPen(col.darker(140),2), QBrush(col));
-    animItem->setPos(animSX, animSY);
-    animItem->setZValue(150);
-    drawTowers();
-    // Draw all disks EXCEPT the top disk on source tower
-    drawDisksExcept(from, diskSz);
+    // Rebuild the scene: the source's top disk is hidden while its flight item
+    // stands in for it (redraw skips one disk per flight on each source rod)
+    redrawRods(from,to);
+}
+
+static int bitCount(uint64_t m){int c=0;while(m){m&=m-1;c++;}return c;}
+
+// Arc for moving the top disk of `from` on the predicted board `peg`
+MainWindow::Flight MainWindow::planFlight(int from, int to, const uint64_t peg[3]){
+    Flight f;
+    f.from=from; f.to=to;
+    f.disk=1;
+    while(!(peg[from]&(1ULL<<(f.disk-1)))) f.disk++;
+    f.progress=0.0f;
+    f.sx=towerX(from);
+    f.sy=baseY()-bitCount(peg[from])*diskH();       // top disk Y on source
+    f.ex=towerX(to);
+    f.ey=baseY()-(bitCount(peg[to])+1)*diskH();     // landing Y on dest
+    f.item=nullptr;
+    return f;
+}
+
+// Quadratic bezier with its control point at the arc peak
+QPointF MainWindow::flightPos(const Flight &f, float t){
+    float midX=(f.sx+f.ex)/2.0f;
+    float midY=ANIM_ARC_Y;
+    float x=(1-t)*(1-t)*f.sx + 2*(1-t)*t*midX + t*t*f.ex;
+    float y=(1-t)*(1-t)*f.sy + 2*(1-t)*t*midY  + t*t*f.ey;
+    return QPointF(x,y);
+}
+
+void MainWindow::addFlightItem(Flight &f){
+    int dw = diskW(f.disk);
+    QColor col = diskColor(f.disk);
+    int th = diskThick();
+    f.item = scene->addRect(-dw/2, -th/2, dw, th,
+                            QPen(col.darker(140),2), QBrush(col));
+    f.item->setPos(flightPos(f,f.progress));
+    f.item->setZValue(150);
+}
+
+// Can `next` lift off now, with every disk in the air still flying? It must
+// not take from or land on a rod another flight is landing on, and stepping
+// both arcs forward frame by frame the two disks must never overlap.
+bool MainWindow::canOverlap(const Flight &next){
+    for(const Flight &f:flights){
+        if(f.progress<PIPELINE_START) return false;
+        if(next.from==f.to||next.to==f.to) return false;
+        float hw=(diskW(next.disk)+diskW(f.disk))/2.0f;
+        for(float tn=0,tf=f.progress; tf<1.0f; tn+=animStep,tf+=animStep){
+            QPointF a=flightPos(next,tn), b=flightPos(f,tf);
+            if(std::fabs(a.x()-b.x())<hw && std::fabs(a.y()-b.y())<diskH()) return false;
+        }
+    }
+    return true;
 }
 
-void MainWindow::drawDisksExcept(int skipTower, int skipTopSz){
-    Q_UNUSED(skipTopSz);
-    auto drawFor=[&](Tower &t, int tIdx, bool skipTop){
-        std::stack<int> tmp=t.disks;
-        std::vector<int> lst;
-        while(!tmp.empty()){lst.push_back(tmp.top());tmp.pop();}
-        std::reverse(lst.begin(),lst.end());
+// Level of detail. While a disk is at least LOD_PX on-screen pixels tall it
+// gets the full treatment (shadow, body, shine, number); zoomed in, disks
+// outside the viewport are skipped. Below that, runs of adjacent disks on a
+// rod merge into one stepped-outline polygon at least BAND_PX tall, so a rod
+// never needs more than ROD_H/BAND_PX items whatever the disk count.
+// Identical disks (Game::copies) are one DiskRun on the tower and are drawn
+// as one batch: a path each for shadows, bodies and shines and a single
+// "size×count" label, however many copies the run holds.
+void MainWindow::drawDisksExcept(const int skipTop[3]){
+    int dh=diskH(), th=diskThick();
+    double px=dh*zoom;
+    QRectF vis=view->mapToScene(view->viewport()->rect()).boundingRect();
+
+    auto label=[&](const QString &txt, int x, int dy){
+        if(th<12) return;   // too thin for a legible number
+        QGraphicsTextItem *lbl=scene->addText(txt);
+        lbl->setDefaultTextColor(QColor("#1E1E2E"));
+        lbl->setFont(QFont("Arial",9,QFont::Bold));
+        lbl->setPos(x,dy+th/2-7);
+    };
+    auto drawOne=[&](int cx, int sz, int dy, bool sel){
+        int dw=diskW(sz);
+        QColor col=diskColor(sz);
+        scene->addRect(cx-dw/2+3,dy+3,dw,th,
+                       QPen(Qt::NoPen),QBrush(QColor(0,0,0,90)));
+        scene->addRect(cx-dw/2,dy,dw,th,
+                       QPen(sel?QColor("#F5A623"):col.darker(140),sel?2.5f:1.5f),
+                       QBrush(sel?col.lighter(120):col));
+        scene->addRect(cx-dw/2+4,dy+2,dw-8,std::max(1,th/4),
+                       QPen(Qt::NoPen),QBrush(QColor(255,255,255,55)));
+        label(QString::number(sz),cx-(sz>9?9:5),dy);
+    };
 
+    auto drawFor=[&](Tower &t, int tIdx, int skip){
         int cx=towerX(tIdx);
         int by=baseY();
-        int count=skipTop?(int)lst.size()-1:(int)lst.size();
-
-        for(int i=0;i<count;i++){
-            int sz=lst[i];
-            int dw=diskW(sz);
-            int dy=by-(i+1)*DISK_H;
-            QColor col=diskColor(sz);
-
-            scene->addRect(cx-dw/2+3,dy+3,dw,DISK_H-4,
-                           QPen(Qt::NoPen),QBrush(QColor(0,0,0,90)));
-            scene->addRect(cx-dw/2,dy,dw,DISK_H-4,
-                           QPen(col.darker(140),1.5),QBrush(col));
-            scene->addRect(cx-dw/2+4,dy+2,dw-8,5,
-                           QPen(Qt::NoPen),QBrush(QColor(255,255,255,55)));
-            QGraphicsTextItem *lbl=scene->addText(QString::number(sz));
-            lbl->setDefaultTextColor(QColor("#1E1E2E"));
-            lbl->setFont(QFont("Arial",9,QFont::Bold));
-            lbl->setPos(cx-5,dy+4);
+        int count=t.size()-skip;
+        bool topSel=(tIdx==selectedTower)&&skip==0&&count>0;
+
+        if(px>=LOD_PX){
+            int i=0;   // disks below the current run
+            for(const DiskRun &r:t.runs){
+                if(i>=count) break;
+                int sz=r.size;
+                int n=std::min(r.count,count-i);
+                int sel=topSel&&i+n==count;   // the selected disk is drawn on its own
+                int batch=n-sel;
+                int top=by-(i+batch)*dh, bottom=by-i*dh;
+                bool shown=top<=vis.bottom()&&bottom>=vis.top();
+                if(shown&&batch==1) drawOne(cx,sz,top,false);
+                else if(shown&&batch>1){
+                    int dw=diskW(sz);
+                    QColor col=diskColor(sz);
+                    QPainterPath shadow,body,shine;
+                    for(int k=0;k<batch;k++){
+                        int dy=by-(i+k+1)*dh;
+                        shadow.addRect(cx-dw/2+3,dy+3,dw,th);
+                        body.addRect(cx-dw/2,dy,dw,th);
+                        shine.addRect(cx-dw/2+4,dy+2,dw-8,std::max(1,th/4));
+                    }
+                    scene->addPath(shadow,QPen(Qt::NoPen),QBrush(QColor(0,0,0,90)));
+                    scene->addPath(body,QPen(col.darker(140),1.5f),QBrush(col));
+                    scene->addPath(shine,QPen(Qt::NoPen),QBrush(QColor(255,255,255,55)));
+                    label(QString("%1×%2").arg(sz).arg(batch),cx-14,top);
+                }
+                if(sel) drawOne(cx,sz,by-count*dh,true);
+                i+=n;
+            }
+        } else {
+            std::vector<int> lst;
+            t.list(lst);
+            int g=(int)std::ceil(BAND_PX/px);
+            for(int i=0;i<count;i+=g){
+                int j=std::min(count,i+g);
+                // outline up the left edges, back down the right edges
+                QPolygonF band;
+                for(int k=i;k<j;k++){
+                    int hw=diskW(lst[k])/2;
+                    band<<QPointF(cx-hw,by-k*dh)<<QPointF(cx-hw,by-(k+1)*dh+1);
+                }
+                for(int k=j-1;k>=i;k--){
+                    int hw=diskW(lst[k])/2;
+                    band<<QPointF(cx+hw,by-(k+1)*dh+1)<<QPointF(cx+hw,by-k*dh);
+                }
+                QColor col=diskColor(lst[(i+j-1)/2]);
+                scene->addPolygon(band,QPen(col.darker(140),0),QBrush(col));
+            }
+        }
+        if(topSel){
+            int dw=diskW(t.runs.back().size);
+            int dy=by-count*dh;
+            scene->addRect(cx-dw/2-4,dy-4,dw+8,dh+4,
+                           QPen(QColor("#F5A623"),2.5),QBrush(Qt::NoBrush));
         }
     };
-    drawFor(game.towerA,0,skipTower==0);
-    drawFor(game.towerB,1,skipTower==1);
-    drawFor(game.towerC,2,skipTower==2);
+    drawFor(game.towerA,0,skipTop[0]);
+    drawFor(game.towerB,1,skipTop[1]);
+    drawFor(game.towerC,2,skipTop[2]);
 }
 
 // Called every 16ms during animation
 void MainWindow::onAnimStep(){
-    if(!animating||!animItem) return;
-
-    animProgress += 0.04f;  // completes in ~25 frames (~400ms)
-    if(animProgress>=1.0f) animProgress=1.0f;
-
-    float t=animProgress;
-    // Arc: use quadratic bezier with control point at top
-    // P = (1-t)^2 * start + 2*(1-t)*t * mid + t^2 * end
-    float midX=(animSX+animEX)/2.0f;
-    float midY=animArcY;
-    float x=(1-t)*(1-t)*animSX + 2*(1-t)*t*midX + t*t*animEX;
-    float y=(1-t)*(1-t)*animSY + 2*(1-t)*t*midY  + t*t*animEY;
-
-    animItem->setPos(x,y);
-
-    if(animProgress>=1.0f){
-        animTimer->stop();
-        animating=false;
-        // Remove anim item before redraw
-        scene->removeItem(animItem);
-        delete animItem;
-        animItem=nullptr;
+    ScopedProbe sp(probe, PerfProbe::ANIM_STEP);
+    TRACE_ZONE("MainWindow::onAnimStep");
+    if(probe) probe->animTick(animTimer->interval());
+    if(!animating) return;
+
+    for(Flight &f:flights){
+        QPointF old=flightPos(f,f.progress);
+        f.progress += animStep;  // ~25 frames (~400ms), 4 when fast-forwarded
+        if(f.progress>=1.0f) f.progress=1.0f;
+        if(f.item) f.item->setPos(flightPos(f,f.progress));
+        else if(painterMode) board->updateDisk(old,flightPos(f,f.progress),f.disk);
+    }
+
+    // flights land in the order they started
+    while(!flights.empty() && flights.front().progress>=1.0f){
+        Flight f=flights.front();
+        flights.erase(flights.begin());
+        if(f.item){ scene->removeItem(f.item); delete f.item; }
+        animating=!flights.empty();
+        if(!animating) animTimer->stop();
         // Now execute actual move in game logic
-        finishMove(animFrom,animTo);
+        finishMove(f.from,f.to);
     }
+
+    // auto-solve pipelining: lift the next disk while this one is landing
+    if(animating && autoSolveTimer->isActive() && flights.back().progress>=PIPELINE_START)
+        onAutoSolveStep();
 }
 
 void MainWindow::finishMove(int from, int to){
+    ScopedProbe sp(probe, PerfProbe::FINISH_MOVE);
+    TRACE_ZONE("MainWindow::finishMove");
     QString names[3]={"A","B","C"};
-    game.moveDisk(names[from].toStdString(),names[to].toStdString());
+    if(game.moveDisk(names[from].toStdString(),names[to].toStdString())){
+        session->logMove(from,to,elapsedSeconds);
+        if(probe) probe->moveDone();
+        if(stateGraph&&stateGraph->isVisible())
+            stateGraph->applyMove(game.undoStack.top().diskSize,from,to);
+    }
     updateMoveLog();
-    redraw();
+    redrawRods(from,to);
+    if(game.lastRepeat>=0)
+        updateStatus(game.lastRepeat==0
+                         ? QString("Back to the starting position — you are going in a loop!")
+                         : QString("Same position as after move %1 — you are going in a loop!")
+                               .arg(game.lastRepeat));
     checkWin();
+
+    // play queued input back to back
+    if(!moveQueue.empty()){
+        if(game.isWon()){ clearMoveQueue(); return; }
+        QueuedMove q=moveQueue.front();
+        moveQueue.pop_front();
+        animEnteredMs=q.enteredMs;
+        doMove(q.from,q.to);
+        animStep=ANIM_STEP_FAST;
+    } else if(animEnteredMs>=0){
+        if(game.lastRepeat<0 && !game.isWon())
+            updateStatus(QString("Caught up — last queued move landed %1 ms after input")
+                             .arg(inputClock.elapsed()-animEnteredMs));
+        animEnteredMs=-1;
+    }
 }
 
 void MainWindow::checkWin(){
     if(!game.isWon()) return;
     clockTimer->stop();
     gameRunning=false;
-    int mn=(int)std::pow(2,game.numDisks)-1;
+    uint64_t mn=optimalMoveCount(game.numDisks);
     updateStatus(QString("YOU WON!  Moves: %1  |  Minimum: %2  |  Time: %3s")
-                     .arg(game.moveCount).arg(mn).arg(elapsedSeconds));
+                     .arg(game.moveCount).arg((qulonglong)mn).arg(elapsedSeconds));
     QTimer::singleShot(300,this,&MainWindow::showWinDialog);
 }
 
 // ─── Win dialog ───────────────────────────────────────────────────────────────
 void MainWindow::showWinDialog(){
-    int mn   =(int)std::pow(2,game.numDisks)-1;
-    int extra=game.moveCount-mn;
+    // 2^n no longer fits an int from n = 31 on, so the counts are 64-bit
+    uint64_t mn   =optimalMoveCount(game.numDisks);
+    uint64_t moves=(uint64_t)game.moveCount;
+    uint64_t extra=moves>mn?moves-mn:0;
     QString rating=extra==0?"PERFECT — Minimum moves!":
                          extra<=3?"Excellent!":
                          extra<=10?"Good job!":"Keep practising!";
@@ -469,7 +748,7 @@ void MainWindow::showWinDialog(){
         bl->addWidget(l);
     };
     stat("🎯","Your moves:    ",QString::number(game.moveCount),"#FF922B");
-    stat("⚡","Minimum moves: ",QString::number(mn),           "#51CF66");
+    stat("⚡","Minimum moves: ",QString::number((qulonglong)mn),"#51CF66");
     stat("⏱","Time taken:    ",QString("%1s").arg(elapsedSeconds),"#339AF0");
     stat("⭐","Rating:        ",rating,                         "#FCC419");
     vl.addWidget(box);
@@ -500,14 +779,45 @@ void MainWindow::showWinDialog(){
 
 // ─── Draw ─────────────────────────────────────────────────────────────────────
 void MainWindow::redraw(){
+    ScopedProbe sp(probe, PerfProbe::REDRAW);
+    TRACE_ZONE("MainWindow::redraw");
+    if(painterMode){ board->update(); return; }
     scene->clear();
-    animItem=nullptr;
     dragGhost=nullptr;
     drawTowers();
-    drawDisks();
+    if(flights.empty()) drawDisks();
+    else{
+        int skip[3]={0,0,0};
+        for(const Flight &f:flights) skip[f.from]++;
+        drawDisksExcept(skip);
+        for(Flight &f:flights) addFlightItem(f);
+    }
+    if(dragging) makeDragGhost();
+}
+
+void MainWindow::redrawRods(int a, int b){
+    if(painterMode) board->updateRods(a,b);
+    else redraw();
+}
+
+void MainWindow::setPainterBoard(bool on){
+    if(on==painterMode) return;
+    painterMode=on;
+    // flight and ghost items belong to the scene; the board paints its own
+    for(Flight &f:flights) f.item=nullptr;
+    dragGhost=nullptr;
+    scene->clear();
+    boardStack->setCurrentWidget(on?(QWidget*)board:(QWidget*)view);
+    bool hudOn=hud->isVisible();
+    hud->setParent(on?(QWidget*)board:view->viewport());
+    hud->setVisible(hudOn);
+    redraw();
+    updateStatus(on?"Renderer: QPainter board  (F4 switches back)"
+                   :"Renderer: QGraphicsScene  (F4 switches back)");
 }
 
 void MainWindow::drawTowers(){
+    TRACE_ZONE("MainWindow::drawTowers");
     scene->setBackgroundBrush(QBrush(QColor("#12121F")));
 
     QGraphicsTextItem *ttl=scene->addText("TOWER  OF  HANOI");
@@ -554,42 +864,9 @@ void MainWindow::drawTowers(){
 }
 
 void MainWindow::drawDisks(){
-    auto drawFor=[&](Tower &t,int tIdx){
-        std::stack<int> tmp=t.disks;
-        std::vector<int> lst;
-        while(!tmp.empty()){lst.push_back(tmp.top());tmp.pop();}
-        std::reverse(lst.begin(),lst.end());
-
-        int cx=towerX(tIdx),by=baseY();
-        bool sel=(tIdx==selectedTower);
-
-        for(int i=0;i<(int)lst.size();i++){
-            int sz=lst[i];
-            int dw=diskW(sz);
-            int dy=by-(i+1)*DISK_H;
-            QColor col=diskColor(sz);
-            bool topSel=sel&&(i==(int)lst.size()-1);
-
-            scene->addRect(cx-dw/2+3,dy+3,dw,DISK_H-4,
-                           QPen(Qt::NoPen),QBrush(QColor(0,0,0,90)));
-            scene->addRect(cx-dw/2,dy,dw,DISK_H-4,
-                           QPen(topSel?QColor("#F5A623"):col.darker(140),topSel?2.5f:1.5f),
-                           QBrush(topSel?col.lighter(120):col));
-            scene->addRect(cx-dw/2+4,dy+2,dw-8,5,
-                           QPen(Qt::NoPen),QBrush(QColor(255,255,255,55)));
-            if(topSel)
-                scene->addRect(cx-dw/2-4,dy-4,dw+8,DISK_H+4,
-                               QPen(QColor("#F5A623"),2.5),QBrush(Qt::NoBrush));
-
-            QGraphicsTextItem *lbl=scene->addText(QString::number(sz));
-            lbl->setDefaultTextColor(QColor("#1E1E2E"));
-            lbl->setFont(QFont("Arial",9,QFont::Bold));
-            lbl->setPos(cx-5,dy+4);
-        }
-    };
-    drawFor(game.towerA,0);
-    drawFor(game.towerB,1);
-    drawFor(game.towerC,2);
+    TRACE_ZONE("MainWindow::drawDisks");
+    const int none[3]={0,0,0};
+    drawDisksExcept(none);
 }
 
 // ─── Slots ────────────────────────────────────────────────────────────────────
@@ -601,7 +878,10 @@ void MainWindow::onAutoSolveClicked(){
         return;
     }
     while(!game.solutionQueue.empty()) game.solutionQueue.pop();
-    game.generateSolution(game.numDisks,"A","B","C");
+    // 2^n moves stop fitting in a queue quickly; larger towers compute each
+    // move from the position instead (see nextSolveMove)
+    if(solveFromQueue())
+        game.generateSolution(game.numDisks,"A","B","C");
     selectedTower=-1;
     if(!gameRunning){gameRunning=true;clockTimer->start();}
     btnAutoSolve->setText("⏸  Pause");
@@ -609,9 +889,29 @@ void MainWindow::onAutoSolveClicked(){
     updateStatus("Auto-solving...");
 }
 
+// the window always plays the classic rules, which nextOptimalMove follows
+bool MainWindow::solveFromQueue() const{
+    return game.numDisks<=QUEUE_SOLVE_MAX;
+}
+
+bool MainWindow::nextSolveMove(int &from, int &to){
+    if(solveFromQueue()){
+        if(game.solutionQueue.empty()) return false;
+        const Move &m=game.solutionQueue.front();
+        from=Game::pegIndex(m.from);
+        to=Game::pegIndex(m.to);
+        return true;
+    }
+    uint64_t peg[3];
+    predictedPegs(peg,false);
+    int disk;
+    return nextOptimalMove(peg[0],peg[1],game.numDisks,2,disk,from,to);
+}
+
 void MainWindow::onAutoSolveStep(){
-    if(animating) return;  // wait for animation to finish
-    if(game.solutionQueue.empty()){
+    int from,to;
+    if(!nextSolveMove(from,to)){
+        if(animating) return;  // let the last disks land
         autoSolveTimer->stop();
         clockTimer->stop();
         gameRunning=false;
@@ -620,16 +920,25 @@ void MainWindow::onAutoSolveStep(){
         updateStatus(QString("Auto-solve done!  Moves: %1").arg(game.moveCount));
         return;
     }
-    Move m=game.solutionQueue.front();
-    game.solutionQueue.pop();
-    auto ni=[](const std::string &n){return n=="A"?0:n=="B"?1:2;};
-    doMove(ni(m.from),ni(m.to));
+    if(animating){
+        // only overlap with the disks in the air if the arcs cannot collide
+        uint64_t peg[3];
+        predictedPegs(peg,false);
+        if(!canOverlap(planFlight(from,to,peg))) return;
+        autoSolveTimer->start();   // restart the cadence from this lift
+    }
+    if(solveFromQueue()) game.solutionQueue.pop();
+    doMove(from,to);
 }
 
 void MainWindow::onUndoClicked(){
     if(animating||autoSolveTimer->isActive()) return;
     selectedTower=-1;
-    game.undoMove();
+    if(!game.undoStack.empty()){
+        game.undoMove();
+        session->logUndo(elapsedSeconds);
+        syncStateGraph();
+    }
     redraw();
     updateMoveLog();
     updateStatus("Undo — last move reversed.");
@@ -639,13 +948,16 @@ void MainWindow::onResetClicked(){
     animTimer->stop();
     autoSolveTimer->stop();
     clockTimer->stop();
-    animating=false; animItem=nullptr;
+    animating=false; flights.clear();
+    clearMoveQueue();
     btnAutoSolve->setText("⚡  Auto Solve (Queue)");
     gameRunning=false; elapsedSeconds=0; selectedTower=-1;
     dragging=false; dragFromTower=-1; dragGhost=nullptr;
     labelTimer->setText("Time:  00:00");
     numDisks=comboDiskCount->currentText().toInt();
     game.reset(numDisks);
+    session->snapshot(game,0);
+    syncStateGraph();
     redraw();
     updateMoveLog();
     updateStatus("Game reset!  Click a tower to select a disk, then click where to place it.");
@@ -653,15 +965,18 @@ void MainWindow::onResetClicked(){
 
 void MainWindow::onTimerTick(){
     elapsedSeconds++;
+    session->logClock(elapsedSeconds);
+    session->flush();   // write-behind: one batched write per second
     int m=elapsedSeconds/60,s=elapsedSeconds%60;
     labelTimer->setText(QString("Time:  %1:%2")
                             .arg(m,2,10,QChar('0')).arg(s,2,10,QChar('0')));
 }
 
 void MainWindow::updateMoveLog(){
+    TRACE_ZONE("MainWindow::updateMoveLog");
     moveLogList->clear();
     for(const auto &s:game.moveLog)
-        moveLogList->addItem(QString::fromStdString(s));
+        moveLogList->addItem(QString::fromUtf8(s.data(),(int)s.size()));
     moveLogList->scrollToBottom();
     labelMoveCount->setText(QString("Moves: %1").arg(game.moveCount));
 }
@@ -672,13 +987,30 @@ void MainWindow::onAboutClicked() {
     showAboutDialog();
 }
 
+// The dialog's content is static, so it is built once (on first use, or in
+// idle time after the first frame) and kept hidden between showings.
 void MainWindow::showAboutDialog() {
-    QDialog dlg(this);
-    dlg.setWindowTitle("About — Tower of Hanoi & DSA");
-    dlg.setFixedSize(780, 620);
-    dlg.setStyleSheet("QDialog { background:#12121F; }");
+    if(!aboutDlg) aboutDlg=buildAboutDialog();
+    aboutDlg->exec();
+}
 
-    QVBoxLayout *mainL = new QVBoxLayout(&dlg);
+void MainWindow::prebuildAboutDialog() {
+    if(aboutDlg) return;
+    if(animating||dragging){   // not idle yet; try again later
+        QTimer::singleShot(ABOUT_PREBUILD_MS, this, &MainWindow::prebuildAboutDialog);
+        return;
+    }
+    aboutDlg=buildAboutDialog();
+}
+
+QDialog *MainWindow::buildAboutDialog() {
+    TRACE_ZONE("MainWindow::buildAboutDialog");
+    QDialog *dlg = new QDialog(this);
+    dlg->setWindowTitle("About — Tower of Hanoi & DSA");
+    dlg->setFixedSize(780, 620);
+    dlg->setStyleSheet("QDialog { background:#12121F; }");
+
+    QVBoxLayout *mainL = new QVBoxLayout(dlg);
     mainL->setContentsMargins(0,0,0,0);
     mainL->setSpacing(0);
 
@@ -1291,6 +1623,7 @@ void MainWindow::showAboutDialog() {
                     {"Drag & Drop","Click and drag a disk directly to another tower"},
                     {"↩ Undo","Reverse your last move using the Undo Stack"},
                     {"⚡ Auto Solve","Watch the algorithm solve it step by step using Queue"},
+                    {"F6","Live state graph: every position, yours in orange, the optimal path in blue"},
                     };
     for(auto &c:ctrls){
         QHBoxLayout *cl=new QHBoxLayout;
@@ -1341,7 +1674,7 @@ void MainWindow::showAboutDialog() {
     tabBtns[0]->setChecked(true);
     for(int i=0;i<4;i++){
         QPushButton *btn = tabBtns[i];
-        connect(btn, &QPushButton::clicked, this, [=](){
+        connect(btn, &QPushButton::clicked, dlg, [=](){
             for(auto b:tabBtns) b->setChecked(false);
             btn->setChecked(true);
             pages->setCurrentIndex(i);
@@ -1361,9 +1694,9 @@ void MainWindow::showAboutDialog() {
         "QPushButton{background:#313244;color:#CDD6F4;font-weight:bold;"
         "border-radius:7px;font-size:13px;}"
         "QPushButton:pressed{background:#45475A;}");
-    connect(closeBtn, &QPushButton::clicked, &dlg, &QDialog::accept);
+    connect(closeBtn, &QPushButton::clicked, dlg, &QDialog::accept);
     footL->addWidget(closeBtn);
     mainL->addWidget(footer);
 
-    dlg.exec();
+    return dlg;
 }
@@ -12,16 +12,34 @@
 #include <QGraphicsRectItem>
 #include <QGraphicsTextItem>
 #include <QDialog>
+#include <QStackedWidget>
+#include <QElapsedTimer>
+#include <deque>
+#include <vector>
 #include "game.h"
+#include "session.h"
+#include "perfprobe.h"
+#include "perfhud.h"
+#include "boardwidget.h"
+#include "stategraph.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
+    friend class GuiHarness;   // offscreen replay harness (gui_harness.cpp)
+    friend class BoardWidget;  // paints from the same state as the scene
+    friend class SceneView;    // forwards the wheel to zoomAt
 public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // stage timings for redraw/doMove/onAnimStep/finishMove; nullptr = off
+    void setPerfProbe(PerfProbe *p) { probe = p; }
+    // false = QGraphicsScene view, true = QPainter BoardWidget (F4 toggles)
+    void setPainterBoard(bool on);
+
 protected:
     bool eventFilter(QObject *obj, QEvent *event) override;
+    void closeEvent(QCloseEvent *event) override;
 
 private slots:
     void onAutoSolveClicked();
@@ -40,20 +58,50 @@ private:
     // Drag state
     bool  dragging;
     int   dragFromTower;
+    int   dragDiskSz;
+    QPointF dragPos;
     QGraphicsRectItem *dragGhost;
+    void makeDragGhost();
 
-    // Animation state
-    bool  animating;
-    int   animFrom, animTo;
-    int   animDiskSz;
-    float animProgress;   // 0.0 → 1.0
-    QGraphicsRectItem *animItem;
+    // Animation state: one Flight per disk in the air. Auto-solve starts the
+    // next lift while the previous disk is landing, so several can be active.
+    struct Flight {
+        int   from, to, disk;
+        float progress;                 // 0.0 → 1.0
+        float sx, sy, ex, ey;           // arc keypoints
+        QGraphicsRectItem *item;        // recreated by redraw()
+    };
+    std::vector<Flight> flights;        // oldest first, they land in this order
+    bool  animating;                    // !flights.empty()
+    float animStep;       // progress per frame: ANIM_STEP_NORMAL or ANIM_STEP_FAST
     QTimer *animTimer;
-    // arc keypoints
-    float animSX, animSY, animEX, animEY, animArcY;
+    Flight  planFlight(int from, int to, const uint64_t peg[3]);
+    QPointF flightPos(const Flight &f, float t);
+    void    addFlightItem(Flight &f);
+    bool    canOverlap(const Flight &next);
+
+    // Moves entered while a disk is in the air. They are validated against
+    // the predicted board (game + animating move + queue) when entered and
+    // played back to back, fast-forwarded, once the current disk lands.
+    struct QueuedMove { int from, to; qint64 enteredMs; };
+    std::deque<QueuedMove> moveQueue;
+    QElapsedTimer inputClock;
+    qint64 animEnteredMs;   // input time of the animating move, -1 if not queued
+    void requestMove(int from, int to);
+    void clearMoveQueue();
+    void predictedPegs(uint64_t peg[3], bool withQueue=true);
+    int  predictedTop(int idx);
+
+    double zoom;          // view scale, 1 = whole board (mouse wheel)
+    bool nextSolveMove(int &from, int &to);
+    bool solveFromQueue() const;
 
     QGraphicsScene *scene;
     QGraphicsView  *view;
+    BoardWidget    *board;        // QPainter renderer, shown instead of view (F4)
+    QStackedWidget *boardStack;
+    bool            painterMode;
+    void redrawRods(int a, int b);  // after a move: only its two rods change
     QPushButton    *btnAutoSolve;
     QPushButton    *btnUndo;
     QPushButton    *btnReset;
@@ -70,6 +118,15 @@ private:
     int  elapsedSeconds;
     bool gameRunning;
 
+    SessionStore *session;   // snapshot + journal, survives crashes
+    PerfProbe    *probe;     // active timing sink, nullptr when nobody is looking
+    PerfProbe     hudProbe;
+    PerfHud      *hud;
+    void toggleHud();
+    StateGraphView *stateGraph;   // F6, built on first use
+    void toggleStateGraph();
+    void syncStateGraph();        // after anything but a single move
+
     void handleMousePress(QPointF sp);
     void handleMouseMove(QPointF sp);
     void handleMouseRelease(QPointF sp);
@@ -78,12 +135,17 @@ private:
     void finishMove(int from, int to);    // called after animation done
     void showWinDialog();
     void showAboutDialog();
+    QDialog *aboutDlg;                    // built once, reused (see showAboutDialog)
+    QDialog *buildAboutDialog();
+    void prebuildAboutDialog();
+    bool firstFramePending;               // startup timing until the board first paints
     void checkWin();
 
     void redraw();
+    void zoomAt(int wheelDelta);    // wheel zoom about the cursor (scene view only)
     void drawTowers();
     void drawDisks();
-    void drawDisksExcept(int skipTower, int skipTopSz);
+    void drawDisksExcept(const int skipTop[3]);   // top disks hidden per rod
     void updateMoveLog();
     void updateStatus(const QString &msg);
 
@@ -91,15 +153,27 @@ private:
     int   towerX(int idx);
     int   baseY();
     int   diskW(int sz);
+    int   diskH();          // pitch per disk for the current n, at most DISK_H
+    int   diskThick();      // drawn thickness, leaves a gap between disks
     QColor diskColor(int sz);
 
-    static const int SCENE_W    = 750;
-    static const int SCENE_H    = 400;
-    static const int ROD_H      = 270;
-    static const int BASE_H     = 14;
-    static const int DISK_H     = 26;
-    static const int MAX_DISK_W = 185;
-    static const int MIN_DISK_W = 38;
+    static const int SCENE_W    = BoardPainter::SCENE_W;
+    static const int SCENE_H    = BoardPainter::SCENE_H;
+    static const int ROD_H      = BoardPainter::ROD_H;
+    static const int BASE_H     = BoardPainter::BASE_H;
+    static const int DISK_H     = BoardPainter::DISK_H;     // pitch for small n
+    static const int MAX_UI_DISKS    = 64;
+    static const int QUEUE_SOLVE_MAX = 16; // above this auto-solve skips the queue
+    static constexpr double LOD_PX   = 14.0;  // full per-disk detail from this height
+    static constexpr double BAND_PX  = 6.0;   // minimum on-screen height of a band
+    static constexpr double ZOOM_MAX = 16.0;
+    static const int MAX_DISK_W = BoardPainter::MAX_DISK_W;
+    static const int MIN_DISK_W = BoardPainter::MIN_DISK_W;
+    static constexpr float ANIM_STEP_NORMAL = 0.04f;   // ~25 frames, 400 ms
+    static constexpr float ANIM_STEP_FAST   = 0.25f;   // 4 frames, 64 ms
+    static constexpr float ANIM_ARC_Y       = BoardPainter::ARC_Y;   // arc peak Y
+    static constexpr float PIPELINE_START   = 0.5f;    // earliest overlap: landing half of the arc
+    static const int ABOUT_PREBUILD_MS = 300;   // idle delay after the first frame
 };
 
 #endif
@@ -0,0 +1,70 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : ptr(nullptr), len(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mapHandle(nullptr)
+#endif
+{}
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string &path) {
+    close();
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(fh, &sz) || GetFileType(fh) != FILE_TYPE_DISK) { CloseHandle(fh); return false; }
+    if (sz.QuadPart == 0) { CloseHandle(fh); return true; }
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) { CloseHandle(fh); return false; }
+    void *p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(mh); CloseHandle(fh); return false; }
+    fileHandle = fh;
+    mapHandle = mh;
+    len = (uint64_t)sz.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { ::close(fd); return false; }
+    if (st.st_size == 0) { ::close(fd); return true; }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    len = (uint64_t)st.st_size;
+#endif
+    ptr = static_cast<const uint8_t*>(p);
+    return true;
+}
+
+void MappedFile::close() {
+    if (!ptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(ptr);
+    CloseHandle((HANDLE)mapHandle);
+    CloseHandle((HANDLE)fileHandle);
+    fileHandle = mapHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(ptr), (size_t)len);
+#endif
+    ptr = nullptr;
+    len = 0;
+}
+
+void MappedFile::adviseSequential() {
+#ifndef _WIN32
+    if (ptr) madvise(const_cast<uint8_t*>(ptr), (size_t)len, MADV_SEQUENTIAL);
+#endif
+}
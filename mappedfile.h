@@ -0,0 +1,33 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstdint>
+#include <string>
+
+// Read-only mapping of a whole file (mmap on POSIX, MapViewOfFile on
+// Windows). An empty file opens with data() == nullptr and size() == 0.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // false if the file cannot be opened or is not a mappable regular file
+    bool open(const std::string &path);
+    void close();
+    // hint that the mapping will be read front to back once
+    void adviseSequential();
+
+    const uint8_t *data() const { return ptr; }
+    uint64_t size() const { return len; }
+
+private:
+    const uint8_t *ptr;
+    uint64_t len;
+#ifdef _WIN32
+    void *fileHandle, *mapHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
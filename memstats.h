@@ -0,0 +1,142 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// Byte accounting for the engine containers.
+//
+// Every container in Tower and Game is built on CountingAllocator, which
+// charges each allocation to a MemTag. Counters are process-wide (all Game
+// instances share them) and atomic, so hanoi_sim's worker threads can use
+// them too. The allocator's tag only changes hands on move/swap; a copy of a
+// container is charged to MEM_UNTRACKED so temporary copies (drawing, snapshots)
+// do not show up as growth of the structure they were copied from.
+
+enum MemTag {
+    MEM_UNTRACKED,
+    MEM_TOWER_A,
+    MEM_TOWER_B,
+    MEM_TOWER_C,
+    MEM_UNDO_STACK,
+    MEM_SOLUTION_QUEUE,
+    MEM_MOVE_LOG,        // the vector plus each line's heap buffer
+    MEM_SCENE,           // set from outside (no allocator hook into Qt)
+    MEM_TAG_COUNT
+};
+
+inline const char *memTagName(int tag) {
+    static const char *names[MEM_TAG_COUNT] = {
+        "untracked", "towerA", "towerB", "towerC", "undoStack", "solutionQueue", "moveLog", "scene"};
+    return tag >= 0 && tag < MEM_TAG_COUNT ? names[tag] : "?";
+}
+
+struct MemCounter {
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<int64_t> allocs{0};   // live allocations
+
+    void add(int64_t n) {
+        int64_t now = bytes.fetch_add(n, std::memory_order_relaxed) + n;
+        allocs.fetch_add(1, std::memory_order_relaxed);
+        raisePeak(now);
+    }
+    void sub(int64_t n) {
+        bytes.fetch_sub(n, std::memory_order_relaxed);
+        allocs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    void set(int64_t n, int64_t count) {
+        bytes.store(n, std::memory_order_relaxed);
+        allocs.store(count, std::memory_order_relaxed);
+        raisePeak(n);
+    }
+    void raisePeak(int64_t now) {
+        int64_t p = peak.load(std::memory_order_relaxed);
+        while (now > p && !peak.compare_exchange_weak(p, now, std::memory_order_relaxed)) {}
+    }
+};
+
+inline MemCounter &memCounter(int tag) {
+    static MemCounter counters[MEM_TAG_COUNT];
+    return counters[tag];
+}
+
+template <class T>
+class CountingAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    CountingAllocator() : tag(MEM_UNTRACKED) {}
+    explicit CountingAllocator(int t) : tag(t) {}
+    template <class U>
+    CountingAllocator(const CountingAllocator<U> &o) : tag(o.tag) {}
+
+    T *allocate(std::size_t n) {
+        T *p = std::allocator<T>().allocate(n);
+        memCounter(tag).add((int64_t)(n * sizeof(T)));
+        return p;
+    }
+    void deallocate(T *p, std::size_t n) {
+        memCounter(tag).sub((int64_t)(n * sizeof(T)));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    CountingAllocator select_on_container_copy_construction() const { return CountingAllocator(); }
+
+    int tag;
+};
+
+template <class T, class U>
+bool operator==(const CountingAllocator<T> &a, const CountingAllocator<U> &b) { return a.tag == b.tag; }
+template <class T, class U>
+bool operator!=(const CountingAllocator<T> &a, const CountingAllocator<U> &b) { return a.tag != b.tag; }
+
+typedef std::basic_string<char, std::char_traits<char>, CountingAllocator<char>> CountedString;
+
+// Snapshot of every counter.
+struct MemoryReport {
+    struct Entry { const char *name; int64_t bytes, peak, allocs; };
+    Entry entry[MEM_TAG_COUNT];
+
+    int64_t totalBytes() const {
+        int64_t t = 0;
+        for (int i = 0; i < MEM_TAG_COUNT; i++) t += entry[i].bytes;
+        return t;
+    }
+};
+
+inline MemoryReport memoryReport() {
+    MemoryReport r;
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        MemCounter &c = memCounter(i);
+        r.entry[i] = {memTagName(i), c.bytes.load(std::memory_order_relaxed),
+                      c.peak.load(std::memory_order_relaxed), c.allocs.load(std::memory_order_relaxed)};
+    }
+    return r;
+}
+
+inline void memResetPeaks() {
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        MemCounter &c = memCounter(i);
+        c.peak.store(c.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+inline void printMemoryReport(FILE *f, const MemoryReport &r) {
+    fprintf(f, "%-14s %12s %12s %8s\n", "structure", "bytes", "peak", "allocs");
+    for (int i = 0; i < MEM_TAG_COUNT; i++) {
+        const MemoryReport::Entry &e = r.entry[i];
+        if (!e.peak) continue;
+        fprintf(f, "%-14s %12lld %12lld %8lld\n", e.name, (long long)e.bytes, (long long)e.peak,
+                (long long)e.allocs);
+    }
+}
+
+#endif // MEMSTATS_H
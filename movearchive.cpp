@@ -0,0 +1,173 @@
+#include "movearchive.h"
+#include "movefile.h"
+#include <cstring>
+
+static const char ARCHIVE_MAGIC[4] = {'H', 'N', 'M', 'A'};
+
+bool applyPegMove(uint64_t peg[3], int from, int to, int *disk) {
+    if (from < 0 || from > 2 || to < 0 || to > 2 || from == to) return false;
+    uint64_t s = peg[from], d = peg[to];
+    if (s == 0) return false;
+    uint64_t top = s & (0 - s);
+    if (d != 0 && (d & (0 - d)) < top) return false;
+    peg[from] = s ^ top;
+    peg[to] = d ^ top;
+    if (disk) *disk = __builtin_ctzll(top) + 1;
+    return true;
+}
+
+// ─── Writer ───────────────────────────────────────────────────────────────────
+MoveArchiveWriter::MoveArchiveWriter() : f(nullptr), failed(false) {
+    memset(&hdr, 0, sizeof hdr);
+    peg[0] = peg[1] = peg[2] = 0;
+}
+
+MoveArchiveWriter::~MoveArchiveWriter() {
+    if (f) close();
+}
+
+bool MoveArchiveWriter::open(const std::string &path, int numDisks,
+                             const uint64_t start[3], const uint64_t target[3],
+                             uint32_t checkpointEvery, uint32_t blockMoves) {
+    if (numDisks < 1 || numDisks > 64 || checkpointEvery == 0 || blockMoves < 2) return false;
+    f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    memset(&hdr, 0, sizeof hdr);
+    memcpy(hdr.magic, ARCHIVE_MAGIC, 4);
+    hdr.version = 1;
+    hdr.numPegs = 3;
+    hdr.numDisks = (uint8_t)numDisks;
+    hdr.blockMoves = blockMoves & ~1u;   // whole bytes per block
+    hdr.checkpointEvery = checkpointEvery;
+    for (int p = 0; p < 3; p++) {
+        hdr.start[p] = start[p];
+        hdr.target[p] = target[p];
+        peg[p] = start[p];
+    }
+    failed = false;
+    block.clear();
+    block.reserve(hdr.blockMoves / 2);
+    checkpoints.assign(peg, peg + 3);
+
+    // placeholder header; the real one is written by close()
+    if (fwrite(&hdr, sizeof hdr, 1, f) != 1) failed = true;
+    return !failed;
+}
+
+bool MoveArchiveWriter::append(int from, int to) {
+    if (!f || failed) return false;
+    if (!applyPegMove(peg, from, to, nullptr)) return false;
+
+    uint8_t nib = packMove(from, to);
+    if ((hdr.moveCount & 1) == 0) block.push_back(nib);
+    else block.back() |= (uint8_t)(nib << 4);
+    hdr.moveCount++;
+
+    if (hdr.moveCount % hdr.checkpointEvery == 0)
+        checkpoints.insert(checkpoints.end(), peg, peg + 3);
+    if (hdr.moveCount % hdr.blockMoves == 0) flushBlock();
+    return !failed;
+}
+
+bool MoveArchiveWriter::flushBlock() {
+    if (!block.empty() && fwrite(block.data(), 1, block.size(), f) != block.size())
+        failed = true;
+    block.clear();
+    return !failed;
+}
+
+bool MoveArchiveWriter::close() {
+    if (!f) return false;
+    flushBlock();
+
+    // checkpoint table starts 8-byte aligned after the moves
+    uint64_t movesEnd = sizeof(MoveArchiveHeader) + (hdr.moveCount + 1) / 2;
+    uint64_t cpOff = (movesEnd + 7) & ~7ULL;
+    static const char zeros[8] = {0};
+    if (cpOff > movesEnd && fwrite(zeros, 1, (size_t)(cpOff - movesEnd), f) != cpOff - movesEnd)
+        failed = true;
+    hdr.checkpointOffset = cpOff;
+    hdr.checkpointCount = checkpoints.size() / 3;
+    if (!checkpoints.empty() &&
+        fwrite(checkpoints.data(), sizeof(uint64_t), checkpoints.size(), f) != checkpoints.size())
+        failed = true;
+
+    if (fseek(f, 0, SEEK_SET) != 0 || fwrite(&hdr, sizeof hdr, 1, f) != 1) failed = true;
+    if (fclose(f) != 0) failed = true;
+    f = nullptr;
+    return !failed;
+}
+
+// ─── Reader ───────────────────────────────────────────────────────────────────
+MoveArchiveReader::MoveArchiveReader()
+    : data(nullptr), size(0), hdr(nullptr), cps(nullptr) {}
+
+MoveArchiveReader::~MoveArchiveReader() { close(); }
+
+bool MoveArchiveReader::fail(const std::string &why) {
+    close();
+    err = why;
+    return false;
+}
+
+bool MoveArchiveReader::open(const std::string &path) {
+    close();
+    err.clear();
+    if (!map.open(path)) return fail("cannot open " + path);
+    if (map.size() < sizeof(MoveArchiveHeader)) return fail(path + " is too small to be a move archive");
+    data = map.data();
+    size = map.size();
+    hdr = reinterpret_cast<const MoveArchiveHeader*>(data);
+
+    if (size < sizeof(MoveArchiveHeader) || memcmp(hdr->magic, ARCHIVE_MAGIC, 4) != 0)
+        return fail(path + " is not a move archive");
+    if (hdr->version != 1 || hdr->numPegs != 3)
+        return fail("unsupported archive version");
+    if (hdr->numDisks < 1 || hdr->numDisks > 64 || hdr->checkpointEvery == 0)
+        return fail("corrupt archive header");
+    // every bound is checked against what is left of the file, so a corrupt
+    // count or offset cannot wrap the arithmetic around
+    uint64_t needCps = hdr->moveCount / hdr->checkpointEvery + 1;
+    uint64_t moveBytes = hdr->moveCount / 2 + (hdr->moveCount & 1);
+    if (moveBytes > size - sizeof(MoveArchiveHeader) ||
+        hdr->checkpointOffset < sizeof(MoveArchiveHeader) + moveBytes ||
+        hdr->checkpointOffset > size ||
+        hdr->checkpointCount < needCps ||
+        hdr->checkpointCount > (size - hdr->checkpointOffset) / 24)
+        return fail("archive is truncated");
+    if (hdr->checkpointOffset % 8 != 0)
+        return fail("corrupt archive header");   // the table is read as uint64_t
+    cps = reinterpret_cast<const uint64_t*>(data + hdr->checkpointOffset);
+    return true;
+}
+
+void MoveArchiveReader::close() {
+    map.close();
+    data = nullptr;
+    hdr = nullptr;
+    cps = nullptr;
+    size = 0;
+}
+
+bool MoveArchiveReader::stateAt(uint64_t i, uint64_t peg[3]) const {
+    if (!data || i > hdr->moveCount) return false;
+    uint64_t c = i / hdr->checkpointEvery;
+    for (int p = 0; p < 3; p++) peg[p] = cps[c * 3 + p];
+    for (uint64_t k = c * hdr->checkpointEvery; k < i; k++) {
+        uint8_t nib = packed(k);
+        if (!applyPegMove(peg, packedFrom(nib), packedTo(nib), nullptr)) return false;
+    }
+    return true;
+}
+
+bool MoveArchiveReader::move(uint64_t i, int &disk, int &from, int &to) const {
+    if (!data || i >= hdr->moveCount) return false;
+    uint8_t nib = packed(i);
+    from = packedFrom(nib);
+    to = packedTo(nib);
+    uint64_t peg[3];
+    if (!stateAt(i, peg) || peg[from] == 0) return false;
+    disk = __builtin_ctzll(peg[from]) + 1;
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef MOVEARCHIVE_H
+#define MOVEARCHIVE_H
+
+#include "mappedfile.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// On-disk archive for very long move sequences ("HNMA", version 1).
+//
+//   [header, 128 bytes]
+//   [moves]        one nibble per move (from << 2 | to), written in blocks of
+//                  blockMoves moves; move i is at byte i / 2, low nibble first
+//   [checkpoints]  peg masks (3 × uint64) of the position after every
+//                  checkpointEvery moves, starting with the start position
+//
+// A reader maps the file and answers "from/to of move i" (packed()) with one
+// byte read and "state at move i" by replaying at most checkpointEvery-1
+// moves from the nearest checkpoint. The disk is not stored, so move() also
+// pays for that replay to find the top disk of the source peg.
+struct MoveArchiveHeader {
+    char     magic[4];          // "HNMA"
+    uint16_t version;           // 1
+    uint8_t  numPegs;           // 3
+    uint8_t  numDisks;
+    uint32_t blockMoves;
+    uint32_t checkpointEvery;
+    uint64_t moveCount;
+    uint64_t checkpointOffset;  // file offset of the checkpoint table
+    uint64_t checkpointCount;
+    uint64_t start[3];          // peg masks, bit k-1 = disk k
+    uint64_t target[3];
+    uint8_t  reserved[40];
+};
+static_assert(sizeof(MoveArchiveHeader) == 128, "MoveArchiveHeader must stay 128 bytes");
+
+// same rules as Game::moveDisk, on peg bitmasks: moves the top disk of
+// `from` to `to` and stores it in *disk (if given); false if illegal
+bool applyPegMove(uint64_t peg[3], int from, int to, int *disk);
+
+class MoveArchiveWriter {
+public:
+    MoveArchiveWriter();
+    ~MoveArchiveWriter();
+
+    bool open(const std::string &path, int numDisks,
+              const uint64_t start[3], const uint64_t target[3],
+              uint32_t checkpointEvery = 4096, uint32_t blockMoves = 1 << 16);
+    // applies the move to the tracked position; illegal moves are rejected
+    bool append(int from, int to);
+    bool close();
+
+    uint64_t moveCount() const { return hdr.moveCount; }
+
+private:
+    FILE *f;
+    MoveArchiveHeader hdr;
+    uint64_t peg[3];
+    std::vector<uint8_t> block;        // current block of packed moves
+    std::vector<uint64_t> checkpoints; // 3 words per checkpoint
+    bool failed;
+
+    bool flushBlock();
+};
+
+class MoveArchiveReader {
+public:
+    MoveArchiveReader();
+    ~MoveArchiveReader();
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    const std::string& error() const { return err; }
+
+    const MoveArchiveHeader& header() const { return *hdr; }
+    uint64_t moveCount() const { return hdr->moveCount; }
+    int numDisks() const { return hdr->numDisks; }
+
+    // i is 0-based; disk is the disk moved by move i, found through stateAt(i)
+    bool move(uint64_t i, int &disk, int &from, int &to) const;
+    // position after the first i moves (0 = start, moveCount() = final)
+    bool stateAt(uint64_t i, uint64_t peg[3]) const;
+
+    // packed nibble of move i (from << 2 | to), no bounds check
+    uint8_t packed(uint64_t i) const {
+        uint8_t b = data[sizeof(MoveArchiveHeader) + i / 2];
+        return (i & 1) ? (uint8_t)(b >> 4) : (uint8_t)(b & 15);
+    }
+
+private:
+    MappedFile map;
+    const uint8_t *data;
+    uint64_t size;
+    const MoveArchiveHeader *hdr;
+    const uint64_t *cps;
+    std::string err;
+
+    bool fail(const std::string &why);
+};
+
+#endif // MOVEARCHIVE_H
@@ -0,0 +1,43 @@
+#ifndef MOVEFILE_H
+#define MOVEFILE_H
+
+#include <cstdint>
+#include <cstring>
+
+// Packed binary move stream ("HNMV"):
+//   16-byte header, then one nibble per move, low nibble first.
+//   nibble = from << 2 | to, pegs 0/1/2 = A/B/C.
+// An odd move count leaves the last high nibble zero. `rules` is the
+// MoveRules mask (variant.h) the moves follow; files written before it was
+// recorded have 0 there, which means classic.
+struct MoveFileHeader {
+    char     magic[4];      // "HNMV"
+    uint8_t  version;       // 1
+    uint8_t  numDisks;
+    uint16_t rules;         // MoveRules::mask, 0 = classic
+    uint64_t moveCount;
+};
+static_assert(sizeof(MoveFileHeader) == 16, "MoveFileHeader must stay 16 bytes");
+
+static const char    MOVEFILE_MAGIC[4] = {'H', 'N', 'M', 'V'};
+static const uint8_t MOVEFILE_VERSION  = 1;
+
+inline MoveFileHeader makeMoveFileHeader(int numDisks, uint64_t moveCount, uint16_t rules = 0) {
+    MoveFileHeader h;
+    memcpy(h.magic, MOVEFILE_MAGIC, 4);
+    h.version = MOVEFILE_VERSION;
+    h.numDisks = (uint8_t)numDisks;
+    h.rules = rules;
+    h.moveCount = moveCount;
+    return h;
+}
+
+inline bool isMoveFileHeader(const void *p, size_t len) {
+    return len >= sizeof(MoveFileHeader) && memcmp(p, MOVEFILE_MAGIC, 4) == 0;
+}
+
+inline uint8_t packMove(int from, int to) { return (uint8_t)(from << 2 | to); }
+inline int     packedFrom(uint8_t nib)    { return nib >> 2; }
+inline int     packedTo(uint8_t nib)      { return nib & 3; }
+
+#endif // MOVEFILE_H
@@ -0,0 +1,75 @@
+#ifndef MOVEFORMAT_H
+#define MOVEFORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+// Hand-rolled formatting for move lines — no streams, no allocation.
+// Every function writes at `p` and returns the new end; callers reserve
+// MOVE_LINE_MAX bytes per line.
+static const int MOVE_LINE_MAX = 96;
+
+inline char* writeUInt(char *p, uint64_t v) {
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[20];
+    char *t = tmp + 20;
+    while (v >= 100) {
+        unsigned r = (unsigned)(v % 100);
+        v /= 100;
+        t -= 2;
+        memcpy(t, pairs + r * 2, 2);
+    }
+    if (v >= 10) { t -= 2; memcpy(t, pairs + v * 2, 2); }
+    else         { *--t = (char)('0' + v); }
+    size_t len = (size_t)(tmp + 20 - t);
+    memcpy(p, t, len);
+    return p + len;
+}
+
+inline char* writeLit(char *p, const char *s, size_t len) {
+    memcpy(p, s, len);
+    return p + len;
+}
+
+// "k. Disk d: A -> C" — the format Game keeps in moveLog
+inline char* formatMoveText(char *p, uint64_t k, int disk, int from, int to) {
+    p = writeUInt(p, k);
+    p = writeLit(p, ". Disk ", 7);
+    p = writeUInt(p, (uint64_t)disk);
+    p = writeLit(p, ": ", 2);
+    *p++ = (char)('A' + from);
+    p = writeLit(p, " -> ", 4);
+    *p++ = (char)('A' + to);
+    return p;
+}
+
+// "k,d,A,C"
+inline char* formatMoveCsv(char *p, uint64_t k, int disk, int from, int to) {
+    p = writeUInt(p, k);
+    *p++ = ',';
+    p = writeUInt(p, (uint64_t)disk);
+    *p++ = ',';
+    *p++ = (char)('A' + from);
+    *p++ = ',';
+    *p++ = (char)('A' + to);
+    return p;
+}
+
+// {"move":k,"disk":d,"from":"A","to":"C"}
+inline char* formatMoveJson(char *p, uint64_t k, int disk, int from, int to) {
+    p = writeLit(p, "{\"move\":", 8);
+    p = writeUInt(p, k);
+    p = writeLit(p, ",\"disk\":", 8);
+    p = writeUInt(p, (uint64_t)disk);
+    p = writeLit(p, ",\"from\":\"", 9);
+    *p++ = (char)('A' + from);
+    p = writeLit(p, "\",\"to\":\"", 8);
+    *p++ = (char)('A' + to);
+    p = writeLit(p, "\"}", 2);
+    return p;
+}
+
+#endif // MOVEFORMAT_H
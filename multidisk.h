@@ -0,0 +1,130 @@
+#ifndef MULTIDISK_H
+#define MULTIDISK_H
+
+#include "solver.h"
+#include <cstdint>
+
+// Towers with m identical copies of every size ("generalized Hanoi with
+// multiplicities"). Equal disks may sit on each other, so a run of equal
+// disks moves as a block: `count` single-disk moves of the same size between
+// the same two pegs, which reverses the run.
+//
+//   unordered    copies are interchangeable. The classic solution with every
+//                move replaced by a block of m: m(2^n - 1) moves.
+//   keep order   each run must end up in its starting order. Moving the upper
+//                n-1 sizes there and back (unordered) around the largest
+//                block reverses every run twice, so only the largest block's
+//                two moves need care: x->z, z->y instead of one reversing
+//                x->y. The smallest size, moved alone, splits into m-1, 1,
+//                m-1. Total m(2^(n+1) - 2) - 1 moves for m >= 2, the known
+//                optimum (2^(n+2) - 5 for the double tower).
+//
+// MultiStream produces the block moves one at a time from a few counters,
+// every classic stretch coming from optimalMove(), so memory is O(1) for any
+// n and m and nothing is ever expanded to single disks unless the caller
+// wants them.
+
+struct BlockMove {
+    int disk, from, to, count;
+};
+
+// single-disk moves in the solution
+inline uint64_t multiMoveCount(int n, int m, bool keepOrder) {
+    if (n < 1 || m < 1) return 0;
+    if (m == 1 || !keepOrder) return (uint64_t)m * optimalMoveCount(n);
+    return (uint64_t)m * ((2ULL << n) - 2) - 1;
+}
+
+// block moves in the solution
+inline uint64_t multiBlockCount(int n, int m, bool keepOrder) {
+    if (n < 1 || m < 1) return 0;
+    if (m == 1 || !keepOrder) return optimalMoveCount(n);
+    return (2ULL << n) - 1;
+}
+
+class MultiStream {
+public:
+    static constexpr int MAX_SIZES = 58;   // m(2^(n+1)) single moves stay in 64 bits for m <= 16
+
+    MultiStream(int n, int m, bool keepOrder, int from = 0, int to = 2)
+        : m(m), x(from), y(to), z(3 - from - to), k(n), j(1), blocks(0), disks(0) {
+        if (n < 1 || n > MAX_SIZES || m < 1 || from == to) phase = DONE;
+        else if (m == 1 || !keepOrder) phase = TOWER;
+        else phase = n > 1 ? CLEAR : SPLIT_OUT;
+    }
+
+    // false once the solution is complete
+    bool next(BlockMove &b) {
+        for (;;) {
+            switch (phase) {
+            case TOWER:
+                if (j <= optimalMoveCount(k)) { classic(k, x, y, m, b); return emit(b); }
+                phase = DONE;
+                continue;
+            case CLEAR:    // sizes 1..k-1 onto y, out of the way
+            case RETURN:   // ... and back onto x, every run the right way up again
+                if (j <= optimalMoveCount(k - 1)) {
+                    if (phase == CLEAR) classic(k - 1, x, y, m, b);
+                    else                classic(k - 1, y, x, m, b);
+                    return emit(b);
+                }
+                j = 1;
+                phase = phase == CLEAR ? OUT : IN;
+                continue;
+            case OUT:
+                b = BlockMove{k, x, z, m};
+                phase = RETURN;
+                return emit(b);
+            case IN:
+                b = BlockMove{k, z, y, m};
+                k--;
+                phase = k > 1 ? CLEAR : SPLIT_OUT;
+                return emit(b);
+            case SPLIT_OUT:
+                b = BlockMove{1, x, z, m - 1};
+                phase = SPLIT_MID;
+                return emit(b);
+            case SPLIT_MID:
+                b = BlockMove{1, x, y, 1};
+                phase = SPLIT_IN;
+                return emit(b);
+            case SPLIT_IN:
+                b = BlockMove{1, z, y, m - 1};
+                phase = DONE;
+                return emit(b);
+            case DONE:
+                return false;
+            }
+        }
+    }
+
+    uint64_t blocksEmitted() const { return blocks; }
+    uint64_t disksEmitted() const { return disks; }
+
+private:
+    enum Phase { TOWER, CLEAR, OUT, RETURN, IN, SPLIT_OUT, SPLIT_MID, SPLIT_IN, DONE };
+
+    int m, x, y, z;
+    int k;          // largest size still to place
+    uint64_t j;     // next move of the current classic stretch
+    Phase phase;
+    uint64_t blocks, disks;
+
+    // j-th move of the classic solution for t sizes from a to c, as blocks
+    void classic(int t, int a, int c, int count, BlockMove &b) {
+        const int peg[3] = {a, 3 - a - c, c};
+        int f, to;
+        optimalMove(t, j++, b.disk, f, to);
+        b.from = peg[f];
+        b.to = peg[to];
+        b.count = count;
+    }
+
+    bool emit(const BlockMove &b) {
+        blocks++;
+        disks += (uint64_t)b.count;
+        return true;
+    }
+};
+
+#endif // MULTIDISK_H
@@ -0,0 +1,67 @@
+#ifndef OUTBUF_H
+#define OUTBUF_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Large reusable output buffer over a FILE*. Callers format straight into
+// reserve()d space and commit() the end pointer; the buffer is flushed with a
+// single fwrite when full. Blocks that are already formatted elsewhere can be
+// passed to writeBlock(), which writes them without copying.
+class OutputBuffer {
+public:
+    explicit OutputBuffer(FILE *f, size_t capacity = 4 << 20)
+        : out(f), buf(capacity), used(0), failed(false), total(0) {
+        setvbuf(out, nullptr, _IONBF, 0);
+    }
+    ~OutputBuffer() { flush(); }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    // pointer to at least `bytes` free bytes
+    char* reserve(size_t bytes) {
+        if (used + bytes > buf.size()) {
+            flush();
+            if (bytes > buf.size()) buf.resize(bytes);
+        }
+        return buf.data() + used;
+    }
+    void commit(char *end) { used = (size_t)(end - buf.data()); }
+
+    void write(const void *data, size_t len) {
+        char *p = reserve(len);
+        memcpy(p, data, len);
+        commit(p + len);
+    }
+
+    void writeBlock(const char *data, size_t len) {
+        flush();
+        putBytes(data, len);
+    }
+
+    void flush() {
+        if (used) putBytes(buf.data(), used);
+        used = 0;
+    }
+
+    bool ok() const { return !failed; }
+    unsigned long long bytesWritten() const { return total + used; }
+
+private:
+    FILE *out;
+    std::vector<char> buf;
+    size_t used;
+    bool failed;
+    unsigned long long total;
+
+    void putBytes(const char *p, size_t len) {
+        if (failed || len == 0) return;
+        if (fwrite(p, 1, len, out) != len) failed = true;
+        total += len;
+    }
+};
+
+#endif // OUTBUF_H
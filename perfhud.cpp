@@ -0,0 +1,112 @@
+#include "perfhud.h"
+#include <QPainter>
+#include <QFont>
+#include <algorithm>
+#include <vector>
+
+// Qt allocates scene items outside our allocators, so the scene entry is an
+// estimate: item count times the typical heap footprint of a shape item
+// (QGraphicsItem + its private d-pointer, pen, brush, geometry).
+static const int64_t SCENE_ITEM_BYTES = 256;
+
+PerfHud::PerfHud(QWidget *parent, PerfProbe *p, QGraphicsScene *s)
+    : QWidget(parent), probe(p), scene(s), sceneItems(0)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFixedSize(300, 278);
+    move(8, 8);
+
+    refresh = new QTimer(this);
+    refresh->setInterval(250);
+    connect(refresh, &QTimer::timeout, this, [this](){
+        sampleScene();
+        update();
+    });
+    QWidget::setVisible(false);
+}
+
+void PerfHud::setVisible(bool on){
+    QWidget::setVisible(on);
+    if(on){ sampleScene(); refresh->start(); raise(); }
+    else    refresh->stop();
+}
+
+void PerfHud::sampleScene(){
+    sceneItems=(int)scene->items().size();
+    memCounter(MEM_SCENE).set(sceneItems*SCENE_ITEM_BYTES, sceneItems);
+}
+
+void PerfHud::histogram(const RingBuffer<int64_t, PerfProbe::RING> &r, int hist[BUCKETS],
+                        double &medianUs, double &p99Us){
+    std::fill(hist, hist+BUCKETS, 0);
+    std::vector<int64_t> v;
+    v.reserve(r.size());
+    for(int i=0;i<r.size();i++){
+        int64_t us=r[i]/1000;
+        int b=0;
+        while(b<BUCKETS-1 && us>=(2LL<<b)) b++;
+        hist[b]++;
+        v.push_back(r[i]);
+    }
+    medianUs=p99Us=0;
+    if(v.empty()) return;
+    std::sort(v.begin(),v.end());
+    medianUs=v[v.size()/2]/1000.0;
+    p99Us=v[std::min(v.size()-1,(size_t)(v.size()*0.99))]/1000.0;
+}
+
+void PerfHud::paintEvent(QPaintEvent *){
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(QPen(QColor("#313244"),1));
+    p.setBrush(QColor(18,18,31,220));
+    p.drawRoundedRect(rect().adjusted(0,0,-1,-1),8,8);
+
+    QFont f("Courier New",8);
+    f.setBold(true);
+    p.setFont(f);
+    int y=16;
+    auto line=[&](const QString &txt,const QColor &col){
+        p.setPen(col);
+        p.drawText(10,y,txt);
+        y+=14;
+    };
+    line("PERF HUD  (F3 to hide)",QColor("#89B4FA"));
+
+    auto drawHist=[&](const char *name,const RingBuffer<int64_t,PerfProbe::RING> &r,const QColor &col){
+        int hist[BUCKETS]; double med,p99;
+        histogram(r,hist,med,p99);
+        line(QString("%1  med %2us  p99 %3us  (n=%4)").arg(name)
+                 .arg(med,0,'f',0).arg(p99,0,'f',0).arg(r.size()),col);
+        int mx=*std::max_element(hist,hist+BUCKETS);
+        for(int b=0;b<BUCKETS;b++){
+            int h=mx?hist[b]*22/mx:0;
+            p.fillRect(10+b*22,y+22-h,18,h,col);
+        }
+        p.setPen(QColor("#585B70"));
+        p.drawText(10,y+34,"1us");
+        p.drawText(10+(BUCKETS-2)*22,y+34,"2ms+");
+        y+=40;
+    };
+    drawHist("onAnimStep",probe->recent[PerfProbe::ANIM_STEP],QColor("#A6E3A1"));
+    drawHist("redraw    ",probe->recent[PerfProbe::REDRAW],QColor("#FAB387"));
+
+    double jmed=0,jmax=0;
+    if(probe->jitter.size()){
+        std::vector<int64_t> j;
+        for(int i=0;i<probe->jitter.size();i++) j.push_back(probe->jitter[i]);
+        std::sort(j.begin(),j.end());
+        jmed=j[j.size()/2]/1e6;
+        jmax=j.back()/1e6;
+    }
+    MemoryReport mem=memoryReport();
+    auto kb=[&](int tag){ return QString("%1/%2").arg(mem.entry[tag].bytes/1024).arg(mem.entry[tag].peak/1024); };
+
+    line(QString("scene items   %1").arg(sceneItems),QColor("#CDD6F4"));
+    line(QString("moves/sec     %1").arg(probe->movesPerSecond(),0,'f',1),QColor("#CDD6F4"));
+    line(QString("anim jitter   med %1ms  max %2ms").arg(jmed,0,'f',2).arg(jmax,0,'f',2),QColor("#CDD6F4"));
+    line(QString("memory KB (now/peak)  total %1").arg(mem.totalBytes()/1024),QColor("#CDD6F4"));
+    line(QString("  towers %1 %2 %3").arg(kb(MEM_TOWER_A),kb(MEM_TOWER_B),kb(MEM_TOWER_C)),QColor("#CDD6F4"));
+    line(QString("  undo %1  queue %2").arg(kb(MEM_UNDO_STACK),kb(MEM_SOLUTION_QUEUE)),QColor("#CDD6F4"));
+    line(QString("  log %1  scene ~%2").arg(kb(MEM_MOVE_LOG),kb(MEM_SCENE)),QColor("#CDD6F4"));
+}
@@ -0,0 +1,35 @@
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+#include <QWidget>
+#include <QTimer>
+#include <QGraphicsScene>
+#include "perfprobe.h"
+#include "memstats.h"
+
+// Semi-transparent overlay drawn on top of the board view (toggle: F3).
+// Reads the PerfProbe ring buffers four times a second while visible and
+// does no work at all while hidden.
+class PerfHud : public QWidget {
+public:
+    PerfHud(QWidget *parent, PerfProbe *probe, QGraphicsScene *scene);
+
+    void setVisible(bool on) override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    PerfProbe      *probe;
+    QGraphicsScene *scene;
+    QTimer         *refresh;
+    int             sceneItems;
+
+    void sampleScene();
+
+    static const int BUCKETS = 12;   // log2 buckets from 1 µs to 2 ms+
+    void histogram(const RingBuffer<int64_t, PerfProbe::RING> &r, int hist[BUCKETS],
+                   double &medianUs, double &p99Us);
+};
+
+#endif // PERFHUD_H
@@ -0,0 +1,111 @@
+#ifndef PERFPROBE_H
+#define PERFPROBE_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size ring of the most recent N samples; never allocates.
+template <class T, int N>
+class RingBuffer {
+public:
+    RingBuffer() : head(0), count(0) {}
+    void push(T v) {
+        buf[head] = v;
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+    void clear() { head = 0; count = 0; }
+    int size() const { return count; }
+    // 0 = oldest kept sample
+    T operator[](int i) const { return buf[(head - count + i + N) % N]; }
+    T newest() const { return buf[(head - 1 + N) % N]; }
+
+private:
+    T buf[N];
+    int head, count;
+};
+
+// Optional timing sink for the GUI hot paths. MainWindow holds a null
+// pointer unless the HUD or a harness is attached, so an unprobed build pays
+// one branch per stage.
+class PerfProbe {
+public:
+    enum Stage { REDRAW, DO_MOVE, ANIM_STEP, FINISH_MOVE, PAINT, STAGE_COUNT };
+    static const int RING = 256;
+
+    static const char* stageName(int s) {
+        static const char *names[STAGE_COUNT] = {"redraw", "doMove", "onAnimStep", "finishMove", "paint"};
+        return names[s];
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    PerfProbe() : keepAll(false), lastAnimTick(0) {}
+
+    void record(Stage s, int64_t ns) {
+        recent[s].push(ns);
+        if (keepAll) samples[s].push_back(ns);
+    }
+
+    // animation timer tick: jitter = actual gap - nominal interval
+    void animTick(int intervalMs) {
+        int64_t now = nowNs();
+        int64_t gap = now - lastAnimTick;
+        // a long gap is the pause between two animations, not jitter
+        if (lastAnimTick && gap < 10LL * intervalMs * 1000000) jitter.push(gap - intervalMs * 1000000LL);
+        lastAnimTick = now;
+    }
+
+    void moveDone() { moveTimes.push(nowNs()); }
+
+    // completed moves in the last `windowNs`
+    double movesPerSecond(int64_t windowNs = 1000000000) const {
+        int64_t now = nowNs();
+        int n = 0;
+        for (int i = moveTimes.size() - 1; i >= 0 && now - moveTimes[i] <= windowNs; i--) n++;
+        return n * 1e9 / windowNs;
+    }
+
+    void clear() {
+        for (auto &v : samples) v.clear();
+        for (auto &r : recent) r.clear();
+        jitter.clear();
+        moveTimes.clear();
+        lastAnimTick = 0;
+    }
+
+    bool keepAll;                                   // also keep every sample (harness)
+    std::vector<int64_t> samples[STAGE_COUNT];
+    RingBuffer<int64_t, RING> recent[STAGE_COUNT];  // ns per call
+    RingBuffer<int64_t, RING> jitter;               // ns
+    RingBuffer<int64_t, RING> moveTimes;            // ns timestamps
+
+private:
+    int64_t lastAnimTick;
+};
+
+// Times its own scope into `probe` (if any).
+class ScopedProbe {
+public:
+    ScopedProbe(PerfProbe *p, PerfProbe::Stage s) : probe(p), stage(s) {
+        if (probe) t0 = std::chrono::steady_clock::now();
+    }
+    ~ScopedProbe() {
+        if (probe)
+            probe->record(stage, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - t0).count());
+    }
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    PerfProbe *probe;
+    PerfProbe::Stage stage;
+    std::chrono::steady_clock::time_point t0;
+};
+
+#endif // PERFPROBE_H
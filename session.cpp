@@ -0,0 +1,208 @@
+#include "session.h"
+#include "movefile.h"
+#include <cstddef>
+#include <cstring>
+#include <stack>
+
+// Version 2 appends the game's rules and duplicate-disk settings; a version 1
+// header stops before them and restores the classic one-copy game.
+struct SnapshotHeader {
+    char     magic[4];       // "HNSS"
+    uint16_t version;        // 2
+    uint8_t  numDisks;
+    uint8_t  reserved;
+    uint32_t elapsedSeconds;
+    uint32_t generation;     // journal records must carry the same generation
+    uint64_t moveCount;
+    uint64_t peg[3];         // Tower::mask() of each peg
+    uint64_t historyCount;
+    uint16_t rules;          // MoveRules::mask
+    uint8_t  copies;
+    uint8_t  keepOrder;
+    uint32_t reserved2;
+};
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must stay 64 bytes");
+
+static const size_t SNAP_V1_SIZE = offsetof(SnapshotHeader, rules);
+static const uint16_t SNAP_VERSION = 2;
+
+struct JournalHeader {
+    char     magic[4];       // "HNSJ"
+    uint32_t generation;
+};
+
+static const char SNAP_MAGIC[4]    = {'H', 'N', 'S', 'S'};
+static const char JOURNAL_MAGIC[4] = {'H', 'N', 'S', 'J'};
+static const size_t FLUSH_AT = 4096;   // bytes buffered before a forced write
+static const char *PEGS[3] = {"A", "B", "C"};
+
+SessionStore::SessionStore(const std::string &dir)
+    : snapPath(dir + "/session.snap"), journalPath(dir + "/session.jnl"),
+      journal(nullptr), generation(0), journalCount(0) {}
+
+SessionStore::~SessionStore() {
+    flush();
+    if (journal) fclose(journal);
+}
+
+bool SessionStore::openJournal(bool truncate) {
+    if (journal) fclose(journal);
+    journal = fopen(journalPath.c_str(), truncate ? "wb" : "ab");
+    if (!journal) return false;
+    if (truncate) {
+        JournalHeader h;
+        memcpy(h.magic, JOURNAL_MAGIC, 4);
+        h.generation = generation;
+        fwrite(&h, sizeof h, 1, journal);
+        fflush(journal);
+        journalCount = 0;
+    }
+    return true;
+}
+
+bool SessionStore::snapshot(const Game &g, int elapsedSeconds) {
+    pending.clear();
+
+    // history comes out of the undo stack newest-first
+    MoveStack tmp = g.undoStack;
+    std::vector<uint8_t> nibbles(tmp.size());
+    for (size_t i = tmp.size(); i-- > 0; tmp.pop())
+        nibbles[i] = packMove(Game::pegIndex(tmp.top().from), Game::pegIndex(tmp.top().to));
+
+    SnapshotHeader h;
+    memset(&h, 0, sizeof h);
+    memcpy(h.magic, SNAP_MAGIC, 4);
+    h.version = SNAP_VERSION;
+    h.numDisks = (uint8_t)g.numDisks;
+    h.elapsedSeconds = (uint32_t)elapsedSeconds;
+    h.generation = ++generation;
+    h.moveCount = (uint64_t)g.moveCount;
+    h.peg[0] = g.towerA.mask();
+    h.peg[1] = g.towerB.mask();
+    h.peg[2] = g.towerC.mask();
+    h.historyCount = nibbles.size();
+    h.rules = g.rules.mask;
+    h.copies = (uint8_t)g.copies;
+    h.keepOrder = g.keepOrder ? 1 : 0;
+
+    std::vector<uint8_t> packed((nibbles.size() + 1) / 2);
+    for (size_t i = 0; i < nibbles.size(); i++)
+        packed[i / 2] |= (uint8_t)(nibbles[i] << ((i & 1) * 4));
+
+    std::string tmpPath = snapPath + ".tmp";
+    FILE *f = fopen(tmpPath.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&h, sizeof h, 1, f) == 1 &&
+              (packed.empty() || fwrite(packed.data(), 1, packed.size(), f) == packed.size());
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) { remove(tmpPath.c_str()); return false; }
+    // rename is atomic on POSIX; Windows needs the target removed first
+    remove(snapPath.c_str());
+    if (rename(tmpPath.c_str(), snapPath.c_str()) != 0) return false;
+
+    return openJournal(true);
+}
+
+bool SessionStore::restore(Game &g, int &elapsedSeconds) {
+    FILE *f = fopen(snapPath.c_str(), "rb");
+    if (!f) return false;
+    SnapshotHeader h;
+    memset(&h, 0, sizeof h);
+    bool ok = fread(&h, SNAP_V1_SIZE, 1, f) == 1 && memcmp(h.magic, SNAP_MAGIC, 4) == 0 &&
+              (h.version == 1 || (h.version == SNAP_VERSION &&
+                                  fread((char*)&h + SNAP_V1_SIZE, sizeof h - SNAP_V1_SIZE, 1, f) == 1)) &&
+              h.numDisks >= 1 && h.numDisks <= Zobrist::MAX_DISKS;
+    if (ok && h.version == 1) {
+        h.rules = MoveRules::classic().mask;
+        h.copies = 1;
+        h.keepOrder = 0;
+    }
+    // init() would quietly fall back to one copy; a snapshot it cannot
+    // rebuild exactly is corrupt
+    ok = ok && h.rules != 0 && (h.rules & ~MoveRules::classic().mask) == 0 &&
+         h.copies >= 1 && h.copies <= Tower::MAX_COPIES &&
+         (h.copies == 1 || h.rules == MoveRules::classic().mask);
+    if (!ok) { fclose(f); return false; }
+    std::vector<uint8_t> packed((size_t)((h.historyCount + 1) / 2));
+    ok = packed.empty() || fread(packed.data(), 1, packed.size(), f) == packed.size();
+    fclose(f);
+    if (!ok) return false;
+
+    // a snapshot that fails to replay leaves a fresh game under the old settings
+    const MoveRules oldRules = g.rules;
+    const int oldCopies = g.copies;
+    const bool oldKeepOrder = g.keepOrder;
+    auto fail = [&] {
+        g.rules = oldRules;
+        g.copies = oldCopies;
+        g.keepOrder = oldKeepOrder;
+        g.init(h.numDisks);
+        return false;
+    };
+    g.rules = MoveRules{h.rules};
+    g.copies = h.copies;
+    g.keepOrder = h.keepOrder != 0;
+    g.init(h.numDisks);
+    for (uint64_t i = 0; i < h.historyCount; i++) {
+        uint8_t nib = (packed[i / 2] >> ((i & 1) * 4)) & 15;
+        if (!g.moveDisk(PEGS[packedFrom(nib) % 3], PEGS[packedTo(nib) % 3])) return fail();
+    }
+    if (g.towerA.mask() != h.peg[0] || g.towerB.mask() != h.peg[1] ||
+        g.towerC.mask() != h.peg[2])
+        return fail();
+    elapsedSeconds = (int)h.elapsedSeconds;
+    generation = h.generation;
+
+    // replay the journal tail written after this snapshot
+    size_t replayed = 0;
+    bool journalValid = false, journalClean = true;
+    FILE *j = fopen(journalPath.c_str(), "rb");
+    if (j) {
+        JournalHeader jh;
+        journalValid = fread(&jh, sizeof jh, 1, j) == 1 &&
+                       memcmp(jh.magic, JOURNAL_MAGIC, 4) == 0 && jh.generation == generation;
+        uint8_t rec[4];
+        // a torn final record (crash mid-write) is simply not read; an illegal
+        // move or unknown op is corruption, as in the snapshot, and ends the
+        // replay at the last good record
+        while (journalValid && fread(rec, 4, 1, j) == 1) {
+            int op = rec[0] >> 4, from = (rec[0] >> 2) & 3, to = rec[0] & 3;
+            int t = rec[1] | rec[2] << 8 | rec[3] << 16;
+            bool ok = op == OP_MOVE ? from < 3 && to < 3 && g.moveDisk(PEGS[from], PEGS[to])
+                                    : op == OP_UNDO || op == OP_CLOCK;
+            if (!ok) { journalClean = false; break; }
+            if (op == OP_UNDO) g.undoMove();
+            elapsedSeconds = t;
+            replayed++;
+        }
+        fclose(j);
+    }
+
+    // fold the tail in so the journal stays short, and so a bad record is
+    // never appended to
+    if (replayed || !journalClean) snapshot(g, elapsedSeconds);
+    else openJournal(!journalValid);
+    return true;
+}
+
+void SessionStore::append(int op, int from, int to, int elapsedSeconds) {
+    uint32_t t = elapsedSeconds < 0 ? 0 : elapsedSeconds > 0xFFFFFF ? 0xFFFFFF : (uint32_t)elapsedSeconds;
+    pending.push_back((uint8_t)(op << 4 | from << 2 | to));
+    pending.push_back((uint8_t)t);
+    pending.push_back((uint8_t)(t >> 8));
+    pending.push_back((uint8_t)(t >> 16));
+    journalCount++;
+    if (pending.size() >= FLUSH_AT) flush();
+}
+
+void SessionStore::logMove(int from, int to, int elapsedSeconds) { append(OP_MOVE, from, to, elapsedSeconds); }
+void SessionStore::logUndo(int elapsedSeconds)                   { append(OP_UNDO, 0, 0, elapsedSeconds); }
+void SessionStore::logClock(int elapsedSeconds)                  { append(OP_CLOCK, 0, 0, elapsedSeconds); }
+
+void SessionStore::flush() {
+    if (pending.empty()) return;
+    if (!journal && !openJournal(false)) return;
+    fwrite(pending.data(), 1, pending.size(), journal);
+    fflush(journal);
+    pending.clear();
+}
@@ -0,0 +1,53 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "game.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Crash-safe persistence of the current game.
+//
+// session.snap  compact snapshot: disk count, move rules, copies per size and
+//               keepOrder, move count, elapsed time, peg masks and the move
+//               history packed one nibble per move. Written to a temp file
+//               and renamed into place.
+// session.jnl   append-only journal of 4-byte records (move / undo / clock)
+//               made after that snapshot. Records are buffered and written in
+//               batches (write-behind), so the per-move cost is a few bytes
+//               in memory.
+//
+// restore() loads the snapshot and replays the journal tail through
+// Game::moveDisk / undoMove.
+class SessionStore {
+public:
+    explicit SessionStore(const std::string &dir);
+    ~SessionStore();
+
+    bool restore(Game &g, int &elapsedSeconds);
+    // full snapshot of g; starts a fresh journal
+    bool snapshot(const Game &g, int elapsedSeconds);
+
+    void logMove(int from, int to, int elapsedSeconds);
+    void logUndo(int elapsedSeconds);
+    void logClock(int elapsedSeconds);
+    // writes buffered records with one fwrite + fflush
+    void flush();
+
+    size_t journalRecords() const { return journalCount; }
+
+private:
+    enum Op { OP_MOVE = 1, OP_UNDO = 2, OP_CLOCK = 3 };
+
+    std::string snapPath, journalPath;
+    FILE *journal;
+    uint32_t generation;
+    std::vector<uint8_t> pending;
+    size_t journalCount;
+
+    void append(int op, int from, int to, int elapsedSeconds);
+    bool openJournal(bool truncate);
+};
+
+#endif // SESSION_H
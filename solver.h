@@ -0,0 +1,99 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+
+// Closed-form helpers for the classic three-peg puzzle.
+// Pegs are 0/1/2 (A/B/C); a position is three disk bitmasks, bit k-1 = disk k.
+
+// number of moves in the optimal solution for n disks (n <= 64)
+inline uint64_t optimalMoveCount(int n) {
+    return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+}
+
+// peg bitmask holding the whole tower of n disks (n <= 64). The same number
+// as optimalMoveCount(n), but a position rather than a count.
+inline uint64_t fullTowerMask(int n) {
+    return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+}
+
+// k-th move (1-based) of the optimal solution taking n disks from A to C,
+// computed directly from k without recursion or a queue
+inline void optimalMove(int n, uint64_t k, int &disk, int &from, int &to) {
+    disk = __builtin_ctzll(k) + 1;
+    from = (int)((k & (k - 1)) % 3);
+    to   = (int)(((k | (k - 1)) + 1) % 3);
+    // the bit formula ends on C for odd n and on B for even n
+    if ((n & 1) == 0) {
+        if (from) from = 3 - from;
+        if (to)   to   = 3 - to;
+    }
+}
+
+// position after the first k moves of the optimal solution (n <= 63). Disk d
+// moves on every move whose index has d-1 trailing zeros, ((k >> (d-1)) + 1) / 2
+// times in all, always cycling the same way round: A->C->B for disks of n's
+// parity, A->B->C for the others.
+inline void optimalState(int n, uint64_t k, uint64_t peg[3]) {
+    peg[0] = peg[1] = peg[2] = 0;
+    for (int d = 1; d <= n; d++) {
+        uint64_t moves = ((k >> (d - 1)) + 1) >> 1;
+        int step = ((n - d) & 1) ? 1 : 2;
+        peg[(moves % 3) * step % 3] |= 1ULL << (d - 1);
+    }
+}
+
+// optimal number of moves to gather every disk on `target` from any legal position.
+// Largest disk first: if it is off target it must move once, the smaller disks
+// need 2^(k-1) moves to clear the way, and their target becomes the third peg.
+inline uint64_t distanceToPeg(uint64_t a, uint64_t b, int n, int target) {
+    uint64_t d = 0;
+    for (int k = n; k >= 1; k--) {
+        uint64_t bit = 1ULL << (k - 1);
+        int p = (a & bit) ? 0 : (b & bit) ? 1 : 2;
+        if (p != target) {
+            d += bit;
+            target = 3 - p - target;
+        }
+    }
+    return d;
+}
+
+// optimal number of moves between two legal positions (n <= 63). Disks that
+// already agree from the largest down never move; the largest disk k that
+// differs moves either once, straight across while the smaller disks wait
+// on the third peg, or twice, via the third peg, which wins when both
+// smaller sub-towers sit near the far pegs. Each option is two
+// distanceToPeg() calls, since reaching a tower and leaving it cost the same.
+inline uint64_t positionDistance(const uint64_t s[3], const uint64_t t[3], int n) {
+    auto pegOf = [](const uint64_t p[3], uint64_t bit) { return (p[0] & bit) ? 0 : (p[1] & bit) ? 1 : 2; };
+    int k = n;
+    while (k >= 1 && pegOf(s, 1ULL << (k - 1)) == pegOf(t, 1ULL << (k - 1))) k--;
+    if (k == 0) return 0;
+    int ps = pegOf(s, 1ULL << (k - 1)), pt = pegOf(t, 1ULL << (k - 1)), r = 3 - ps - pt;
+    uint64_t low = (1ULL << (k - 1)) - 1;
+    uint64_t once  = distanceToPeg(s[0] & low, s[1] & low, k - 1, r) + 1
+                   + distanceToPeg(t[0] & low, t[1] & low, k - 1, r);
+    uint64_t twice = distanceToPeg(s[0] & low, s[1] & low, k - 1, pt) + 1 + low + 1
+                   + distanceToPeg(t[0] & low, t[1] & low, k - 1, ps);
+    return once < twice ? once : twice;
+}
+
+// first move of an optimal path from any legal position to all disks on `target`:
+// the smallest disk that is off its (recursively defined) target moves there.
+// Returns false if the position is already solved.
+inline bool nextOptimalMove(uint64_t a, uint64_t b, int n, int target,
+                            int &disk, int &from, int &to) {
+    disk = 0;
+    for (int k = n; k >= 1; k--) {
+        uint64_t bit = 1ULL << (k - 1);
+        int p = (a & bit) ? 0 : (b & bit) ? 1 : 2;
+        if (p != target) {
+            disk = k; from = p; to = target;
+            target = 3 - p - target;
+        }
+    }
+    return disk != 0;
+}
+
+#endif // SOLVER_H
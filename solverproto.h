@@ -0,0 +1,171 @@
+#ifndef SOLVERPROTO_H
+#define SOLVERPROTO_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Wire format of the local solver daemon (hanoi_daemon), spoken over a Unix
+// stream socket. Fixed-size records in host byte order, which is the same on
+// both ends of a local socket.
+//
+//   request   SolverRequestHeader, then `count` SolverQuery records
+//   reply     SolverReplyHeader, then `count` SolverResult records, then the
+//             payloads of the results that have one, in query order
+//
+// A connection may pipeline any number of batches; replies come back in the
+// order the batches were sent, each tagged with its batch id. Positions are
+// the peg A and peg B disk masks (bit k-1 = disk k); peg C holds the rest.
+// Move ranges come back as HNMV nibbles (movefile.h): one per move, low
+// nibble first, from << 2 | to.
+
+enum SolverOp : uint8_t {
+    SOLVER_MOVE_AT = 1,     // arg[0] = k (1-based)              -> disk, from, to
+    SOLVER_STATE_AT,        // arg[0] = k (0 = start)            -> value[0..2] = peg masks
+    SOLVER_DISTANCE,        // arg[0..1] start, arg[2..3] goal   -> value[0] = moves
+    SOLVER_TOWER_DISTANCE,  // arg[0..1] position, target peg    -> value[0] = moves
+    SOLVER_NEXT_MOVE,       // arg[0..1] position, target peg    -> disk, from, to, value[0] = moves left
+    SOLVER_MOVE_RANGE,      // arg[0] = first k, arg[1] = count  -> payload, value[0] = moves in it
+};
+
+enum SolverStatus : uint8_t {
+    SOLVER_OK = 0,
+    SOLVER_BAD_OP,
+    SOLVER_BAD_ARGS,        // disk count, move index, peg or position out of range
+    SOLVER_SOLVED,          // SOLVER_NEXT_MOVE on a finished position
+    SOLVER_TOO_LARGE,       // range over SOLVER_MAX_RANGE or the batch payload limit
+};
+
+static const char     SOLVER_REQUEST_MAGIC[4] = {'H', 'N', 'Q', '1'};
+static const char     SOLVER_REPLY_MAGIC[4]   = {'H', 'N', 'R', '1'};
+static const int      SOLVER_MAX_DISKS        = 63;
+static const uint32_t SOLVER_MAX_BATCH        = 1 << 16;   // queries per request
+static const uint64_t SOLVER_MAX_RANGE        = 1 << 24;   // moves per range query (8 MB)
+static const uint64_t SOLVER_MAX_PAYLOAD      = 1 << 26;   // range bytes per reply
+
+struct SolverRequestHeader {
+    char     magic[4];   // "HNQ1"
+    uint32_t batch;      // echoed in the reply
+    uint32_t count;      // 1..SOLVER_MAX_BATCH
+    uint32_t reserved;
+};
+
+struct SolverQuery {
+    uint8_t  op;         // SolverOp
+    uint8_t  n;          // 1..SOLVER_MAX_DISKS
+    uint8_t  target;     // peg 0..2 for the tower / next-move queries
+    uint8_t  reserved[5];
+    uint64_t arg[4];
+};
+
+struct SolverReplyHeader {
+    char     magic[4];   // "HNR1"
+    uint32_t batch;
+    uint32_t count;
+    uint32_t payload;    // bytes after the results
+};
+
+struct SolverResult {
+    uint8_t  status;     // SolverStatus
+    uint8_t  disk, from, to;
+    uint32_t payload;    // bytes of this result's payload
+    uint64_t value[3];
+};
+
+static_assert(sizeof(SolverRequestHeader) == 16, "SolverRequestHeader must stay 16 bytes");
+static_assert(sizeof(SolverQuery) == 40, "SolverQuery must stay 40 bytes");
+static_assert(sizeof(SolverReplyHeader) == 16, "SolverReplyHeader must stay 16 bytes");
+static_assert(sizeof(SolverResult) == 32, "SolverResult must stay 32 bytes");
+
+// $XDG_RUNTIME_DIR/hanoi-solver.sock, else /tmp/hanoi-solver-<uid>.sock
+inline std::string defaultSolverSocket() {
+    const char *dir = getenv("XDG_RUNTIME_DIR");
+    if (dir && *dir) return std::string(dir) + "/hanoi-solver.sock";
+    return "/tmp/hanoi-solver-" + std::to_string(getuid()) + ".sock";
+}
+
+inline bool makeSolverAddress(const std::string &path, sockaddr_un &addr) {
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+// Blocking client for tools that query the daemon: send() any number of
+// batches, then receive() their replies in the same order.
+class SolverClient {
+public:
+    SolverClient() : fd(-1) {}
+    ~SolverClient() { close(); }
+    SolverClient(const SolverClient &) = delete;
+    SolverClient &operator=(const SolverClient &) = delete;
+
+    bool connect(const std::string &path) {
+        close();
+        sockaddr_un addr;
+        if (!makeSolverAddress(path, addr)) { errno = ENAMETOOLONG; return false; }
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+        if (::connect(fd, (const sockaddr *)&addr, sizeof(addr)) != 0) { close(); return false; }
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    bool send(uint32_t batch, const SolverQuery *q, uint32_t count) {
+        SolverRequestHeader h;
+        memcpy(h.magic, SOLVER_REQUEST_MAGIC, 4);
+        h.batch = batch;
+        h.count = count;
+        h.reserved = 0;
+        return writeAll(&h, sizeof(h)) && writeAll(q, (size_t)count * sizeof(SolverQuery));
+    }
+
+    // next reply; payload holds every range result's bytes back to back
+    bool receive(SolverReplyHeader &h, std::vector<SolverResult> &results, std::vector<uint8_t> &payload) {
+        if (!readAll(&h, sizeof(h)) || memcmp(h.magic, SOLVER_REPLY_MAGIC, 4) != 0) return false;
+        results.resize(h.count);
+        payload.resize(h.payload);
+        return readAll(results.data(), (size_t)h.count * sizeof(SolverResult)) &&
+               readAll(payload.data(), h.payload);
+    }
+
+private:
+    int fd;
+
+    bool writeAll(const void *p, size_t len) {
+        const char *c = (const char *)p;
+        while (len > 0) {
+            ssize_t w = ::send(fd, c, len, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return false;
+            c += w;
+            len -= (size_t)w;
+        }
+        return true;
+    }
+
+    bool readAll(void *p, size_t len) {
+        char *c = (char *)p;
+        while (len > 0) {
+            ssize_t r = ::read(fd, c, len);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            c += r;
+            len -= (size_t)r;
+        }
+        return true;
+    }
+};
+
+#endif // SOLVERPROTO_H
@@ -0,0 +1,67 @@
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Cold-start phase stamps.
+//
+//   startupMark("QApplication");          // ms since process start
+//   ...
+//   startupFirstFrame();                  // MainWindow, after its first paint
+//
+// The origin is taken during static initialisation, before main() runs, so
+// the "main" phase covers the remaining static constructors; everything after
+// that is wall time on the GUI thread.
+// startupReportTo(stderr) makes startupFirstFrame() print the table once.
+
+struct StartupPhase {
+    const char *name;   // must be a string literal
+    double ms;          // since process start
+};
+
+inline int64_t startupNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline const int64_t startupOriginNs = startupNowNs();
+
+inline std::vector<StartupPhase> &startupPhases() {
+    static std::vector<StartupPhase> phases;
+    return phases;
+}
+
+inline FILE *&startupReportFile() {
+    static FILE *f = nullptr;
+    return f;
+}
+
+inline void startupReportTo(FILE *f) { startupReportFile() = f; }
+
+inline void startupMark(const char *phase) {
+    startupPhases().push_back({phase, (startupNowNs() - startupOriginNs) / 1e6});
+}
+
+inline void printStartupTimes(FILE *f) {
+    double prev = 0;
+    fprintf(f, "%-26s %10s %10s\n", "startup phase", "at ms", "delta ms");
+    for (const StartupPhase &p : startupPhases()) {
+        fprintf(f, "%-26s %10.1f %10.1f\n", p.name, p.ms, p.ms - prev);
+        prev = p.ms;
+    }
+}
+
+// Only the first call counts; later paints are ordinary frames.
+inline bool startupFirstFrame() {
+    static bool seen = false;
+    if (seen) return false;
+    seen = true;
+    startupMark("first frame");
+    if (FILE *f = startupReportFile()) printStartupTimes(f);
+    return true;
+}
+
+#endif // STARTUP_H
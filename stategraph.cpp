@@ -0,0 +1,232 @@
+#include "stategraph.h"
+#include "solver.h"
+#include <QPainter>
+#include <QPolygonF>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+
+static const QColor BG("#12121F"), FILL("#45475A"), EDGE("#6C7086"), NODE("#9399B2");
+static const QColor PATH("#89B4FA"), CURRENT("#F5A623"), START("#CDD6F4"), GOAL("#51CF66");
+static const int MARGIN = 16;
+
+StateGraphView::StateGraphView(QWidget *parent)
+    : QWidget(parent), layout(nullptr), n(0), cur(0), pathPos(0),
+      zoom(1.0), panning(false), cacheValid(false), pathLineValid(false)
+{
+    peg[0]=peg[1]=peg[2]=0;
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(240, 220);
+    setWindowTitle("Tower of Hanoi — State graph");
+}
+
+void StateGraphView::setPosition(int disks, const uint64_t p[3]){
+    if(disks!=n){
+        n=disks;
+        layout = n>=1 && n<=StateLayout::MAX_DISKS ? &StateLayout::get(n) : nullptr;
+        zoom=1.0; pan=QPointF();
+        invalidate();
+    }
+    peg[0]=p[0]; peg[1]=p[1]; peg[2]=p[2];
+    if(!layout){ update(); return; }
+    cur=StateLayout::index(peg,n);
+    rebuildPath();
+    update();
+}
+
+void StateGraphView::applyMove(int disk, int from, int to){
+    uint64_t bit=1ULL<<(disk-1);
+    peg[from]&=~bit; peg[to]|=bit;
+    if(!layout) return;
+    uint32_t old=cur;
+    cur=(uint32_t)((int64_t)cur+(int64_t)(to-from)*layout->pow3(disk-1));
+    if(pathPos+1<path.size() && path[pathPos+1]==cur){
+        pathPos++;   // on the path: the old dot and the trimmed segment are all that change
+        update(nodeRect(old).united(nodeRect(cur)));
+        return;
+    }
+    rebuildPath();
+    update();
+}
+
+// at most 2^n - 1 moves; only when the player leaves the path
+void StateGraphView::rebuildPath(){
+    path.clear();
+    pathPos=0;
+    pathLineValid=false;
+    uint64_t a=peg[0], b=peg[1], c=peg[2];
+    uint32_t i=cur;
+    path.push_back(i);
+    int disk,from,to;
+    while(nextOptimalMove(a,b,n,2,disk,from,to)){
+        uint64_t bit=1ULL<<(disk-1);
+        uint64_t *q[3]={&a,&b,&c};
+        *q[from]&=~bit; *q[to]|=bit;
+        i=(uint32_t)((int64_t)i+(int64_t)(to-from)*layout->pow3(disk-1));
+        path.push_back(i);
+    }
+}
+
+double StateGraphView::side() const {
+    double fit=std::min((double)width()-2*MARGIN, (height()-2*MARGIN)/StateLayout::HEIGHT);
+    return std::max(1.0,fit)*zoom;
+}
+
+QPointF StateGraphView::origin() const {
+    double s=side()/zoom;   // fitted size, centred; zoom and pan move it from there
+    QPointF fitted((width()-s)/2, (height()-s*StateLayout::HEIGHT)/2);
+    return fitted+pan;
+}
+
+QPointF StateGraphView::nodePos(uint32_t i) const {
+    double s=side();
+    return origin()+QPointF(layout->x(i)*s, layout->y(i)*s);
+}
+
+QRect StateGraphView::nodeRect(uint32_t i) const {
+    QPointF c=nodePos(i);
+    return QRect((int)c.x()-8,(int)c.y()-8,17,17);
+}
+
+void StateGraphView::invalidate(){ cacheValid=false; pathLineValid=false; update(); }
+
+// Sub-triangle of the positions whose d largest disks are as in `prefix`.
+// Filled as one polygon at the LOD level `stop`; below it, recurses and
+// draws the three moves of disk n-d that join its children.
+void StateGraphView::drawTriangle(QPainter &p, int d, uint32_t prefix, int stop, const QRectF &vis){
+    const int m=n-d;   // disks left inside
+    QPointF c0=nodePos(layout->corner(prefix,m,0));
+    QPointF c1=nodePos(layout->corner(prefix,m,1));
+    QPointF c2=nodePos(layout->corner(prefix,m,2));
+    // upright like the whole, but which corner is which depends on the prefix
+    QRectF box(QPointF(std::min({c0.x(),c1.x(),c2.x()}),std::min({c0.y(),c1.y(),c2.y()})),
+               QPointF(std::max({c0.x(),c1.x(),c2.x()}),std::max({c0.y(),c1.y(),c2.y()})));
+    if(!box.adjusted(-4,-4,4,4).intersects(vis)) return;
+    if(m==0){
+        p.setPen(Qt::NoPen);
+        p.setBrush(NODE);
+        p.drawEllipse(c0,2.0,2.0);
+        return;
+    }
+    if(d==stop){
+        QPolygonF tri;
+        tri<<c0<<c1<<c2;
+        p.setPen(Qt::NoPen);
+        p.setBrush(FILL);
+        p.drawPolygon(tri);
+        return;
+    }
+    if(stop==n){   // full detail: disk m's three moves between the children
+        uint32_t step=layout->pow3(m-1);
+        p.setPen(QPen(EDGE,1));
+        for(int a=0;a<3;a++){
+            int b=(a+1)%3, q=3-a-b;
+            p.drawLine(nodePos(layout->corner(prefix+a*step,m-1,q)),
+                       nodePos(layout->corner(prefix+b*step,m-1,q)));
+        }
+    }
+    for(int a=0;a<3;a++) drawTriangle(p,d+1,prefix+a*layout->pow3(m-1),stop,vis);
+}
+
+void StateGraphView::renderCache(){
+    qreal dpr=devicePixelRatioF();
+    cache=QPixmap(size()*dpr);
+    cache.setDevicePixelRatio(dpr);
+    cache.fill(BG);
+    cacheValid=true;
+    if(!layout) return;
+
+    QPainter p(&cache);
+    p.setRenderHint(QPainter::Antialiasing);
+    // deepest level whose triangles are still MIN_TRI_PX wide; every level
+    // once a single move is NODE_PX long
+    double unit=side()/((1u<<n)-1);
+    int stop=n;
+    if(unit<NODE_PX){
+        stop=0;
+        while(stop<n && side()*((1u<<(n-stop-1))-1)/((1u<<n)-1)>=MIN_TRI_PX) stop++;
+    }
+    drawTriangle(p,0,0,stop,QRectF(rect()));
+}
+
+// Strokes the remaining path where it crosses `dirty`, one polyline per run
+// of consecutive crossing segments so the joins stay smooth.
+void StateGraphView::drawPath(QPainter &p, const QRectF &dirty){
+    if(!pathLineValid){
+        pathLine.clear();
+        for(uint32_t i : path) pathLine<<nodePos(i);
+        pathLineValid=true;
+    }
+    p.setPen(QPen(PATH,2));
+    p.setBrush(Qt::NoBrush);
+    const QPointF *pt=pathLine.constData();
+    size_t run=pathPos;   // first point of the current run
+    for(size_t i=pathPos;i+1<path.size();i++){
+        const QPointF &a=pt[i], &b=pt[i+1];
+        if(std::max(a.x(),b.x())>=dirty.left() && std::min(a.x(),b.x())<=dirty.right() &&
+           std::max(a.y(),b.y())>=dirty.top() && std::min(a.y(),b.y())<=dirty.bottom()) continue;
+        if(i>run) p.drawPolyline(pt+run,(int)(i-run+1));
+        run=i+1;
+    }
+    if(path.size()-1>run) p.drawPolyline(pt+run,(int)(path.size()-run));
+}
+
+void StateGraphView::paintEvent(QPaintEvent *event){
+    if(!cacheValid) renderCache();
+    QPainter p(this);
+    p.drawPixmap(0,0,cache);
+    p.setRenderHint(QPainter::Antialiasing);
+    if(!layout){
+        p.setPen(START);
+        p.drawText(rect(),Qt::AlignCenter,
+                   QString("The state graph is shown for up to %1 disks").arg(StateLayout::MAX_DISKS));
+        return;
+    }
+
+    if(pathPos+1<path.size()) drawPath(p,QRectF(event->rect()).adjusted(-2,-2,2,2));
+    auto dot=[&](uint32_t i,const QColor &col,double r){
+        p.setPen(QPen(BG,1.5));
+        p.setBrush(col);
+        p.drawEllipse(nodePos(i),r,r);
+    };
+    dot(0,START,4);
+    dot(layout->nodes()-1,GOAL,4);
+    dot(cur,CURRENT,6);
+}
+
+void StateGraphView::resizeEvent(QResizeEvent *){ invalidate(); }
+
+void StateGraphView::wheelEvent(QWheelEvent *event){
+    double f=std::pow(1.0015,event->angleDelta().y());
+    double z=std::clamp(zoom*f,1.0,ZOOM_MAX);
+    if(z==zoom) return;
+    // keep the point under the cursor where it is
+    QPointF at=event->position();
+    QPointF o=origin();
+    pan+=(at-o)*(1.0-z/zoom);
+    zoom=z;
+    if(zoom==1.0) pan=QPointF();
+    invalidate();
+}
+
+void StateGraphView::mousePressEvent(QMouseEvent *event){
+    if(event->button()!=Qt::LeftButton) return;
+    panning=true;
+    panFrom=event->position();
+}
+
+void StateGraphView::mouseMoveEvent(QMouseEvent *event){
+    if(!panning) return;
+    pan+=event->position()-panFrom;
+    panFrom=event->position();
+    invalidate();
+}
+
+void StateGraphView::mouseReleaseEvent(QMouseEvent *){ panning=false; }
+
+void StateGraphView::mouseDoubleClickEvent(QMouseEvent *){
+    zoom=1.0;
+    pan=QPointF();
+    invalidate();
+}
@@ -0,0 +1,77 @@
+#ifndef STATEGRAPH_H
+#define STATEGRAPH_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QPointF>
+#include <QPolygonF>
+#include <cstdint>
+#include <vector>
+#include "statelayout.h"
+
+// Live view of the whole state graph (toggle: F6): the Sierpinski layout
+// from StateLayout, the game's position as a dot and the optimal path from
+// it to "all on C" as a line. Wheel zooms about the cursor, dragging pans,
+// double-click fits the window again.
+//
+// The graph itself is rendered into a cached pixmap whenever n, the size or
+// the view changes. Zoomed out, every triangle smaller than MIN_TRI_PX on
+// screen is filled as one polygon instead of drawing the positions inside
+// it, so a frame needs a few thousand polygons at most; nodes and edges
+// appear once a move is at least NODE_PX long. The path's on-screen points
+// are cached too, and a paint strokes only the path segments that cross the
+// dirty rectangle. A move that follows the path moves the dot and trims the
+// path by one node, repainting only the two dots' rectangle, so it strokes a
+// few segments rather than the whole remaining path.
+class StateGraphView : public QWidget {
+public:
+    explicit StateGraphView(QWidget *parent = nullptr);
+
+    // full sync (new game, undo, restore)
+    void setPosition(int n, const uint64_t peg[3]);
+    // one move on top of the last synced position
+    void applyMove(int disk, int from, int to);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    const StateLayout *layout;   // nullptr above StateLayout::MAX_DISKS
+    int      n;
+    uint64_t peg[3];
+    uint32_t cur;                // index of the current position
+    std::vector<uint32_t> path;  // optimal path to the goal, from path[pathPos]
+    size_t   pathPos;
+
+    double  zoom;                // 1 = whole triangle fits
+    QPointF pan;                 // widget pixels
+    bool    panning;
+    QPointF panFrom;
+
+    QPixmap cache;
+    bool    cacheValid;
+    QPolygonF pathLine;          // nodePos() of every path entry, for the current view
+    bool    pathLineValid;
+
+    static constexpr double MIN_TRI_PX = 4.0;
+    static constexpr double NODE_PX    = 10.0;
+    static constexpr double ZOOM_MAX   = 512.0;
+
+    double  side() const;                 // on-screen side of the whole triangle
+    QPointF origin() const;               // on-screen top-left of its bounding box
+    QPointF nodePos(uint32_t i) const;
+    QRect   nodeRect(uint32_t i) const;
+    void    rebuildPath();
+    void    drawPath(QPainter &p, const QRectF &dirty);
+    void    invalidate();
+    void    renderCache();
+    void    drawTriangle(QPainter &p, int d, uint32_t prefix, int stop, const QRectF &vis);
+};
+
+#endif // STATEGRAPH_H
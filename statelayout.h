@@ -0,0 +1,82 @@
+#ifndef STATELAYOUT_H
+#define STATELAYOUT_H
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Sierpinski-triangle layout of the classic puzzle's state graph: 3^n
+// positions, an edge per legal move. A position's index has one base-3 digit
+// per disk (digit k-1 = peg of disk k), so moving disk d from f to t adds
+// (t - f) * 3^(d-1) to it.
+//
+// The largest disk picks one of three corner sub-triangles (A top, B bottom
+// left, C bottom right) and the smaller disks are laid out inside it with
+// the two other corners swapped, which puts every move on a unit-length
+// edge and the classic solution along the right-hand side. Coordinates are
+// in a triangle of side 1 and are built once per n into a packed array of
+// 16+16-bit fixed-point pairs (2 MB at n = 12).
+class StateLayout {
+public:
+    static constexpr int MAX_DISKS = 12;
+    static constexpr double HEIGHT = 0.86602540378443865;   // sqrt(3)/2
+
+    // shared instance for n disks (1..MAX_DISKS), built on first use
+    static const StateLayout &get(int n) {
+        static std::unique_ptr<StateLayout> cache[MAX_DISKS + 1];
+        if (!cache[n]) cache[n].reset(new StateLayout(n));
+        return *cache[n];
+    }
+
+    int numDisks() const { return n; }
+    uint32_t nodes() const { return (uint32_t)xy.size(); }
+    double x(uint32_t i) const { return (xy[i] >> 16) / 65535.0; }
+    double y(uint32_t i) const { return (xy[i] & 0xFFFF) / 65535.0 * HEIGHT; }
+    uint32_t pow3(int k) const { return p3[k]; }
+
+    // index of the position with disks 1..m all on `peg` and the larger ones
+    // as in `prefix` (the corners of that position's level-(n-m) triangle)
+    uint32_t corner(uint32_t prefix, int m, int peg) const { return prefix + (uint32_t)peg * (p3[m] - 1) / 2; }
+
+    static uint32_t index(const uint64_t peg[3], int n) {
+        uint32_t idx = 0, p = 1;
+        for (int k = 1; k <= n; k++, p *= 3)
+            idx += p * (peg[1] >> (k - 1) & 1 ? 1 : peg[2] >> (k - 1) & 1 ? 2 : 0);
+        return idx;
+    }
+
+private:
+    int n;
+    std::vector<uint32_t> xy;   // x << 16 | y, both scaled to 0..65535
+    uint32_t p3[MAX_DISKS + 1];
+
+    explicit StateLayout(int disks) : n(disks) {
+        p3[0] = 1;
+        for (int k = 1; k <= MAX_DISKS; k++) p3[k] = p3[k - 1] * 3;
+        xy.resize(p3[n]);
+        const int perm[3] = {0, 1, 2};
+        build(n, 0, perm, 0.0, 0.0);
+    }
+
+    // disks k..1 still to place; perm maps a peg to the corner it is drawn at
+    void build(int k, uint32_t idx, const int perm[3], double wx, double wy) {
+        static const double CX[3] = {0.5, 0.0, 1.0}, CY[3] = {0.0, 1.0, 1.0};
+        const double unit = 1.0 / (double)((1u << n) - 1);
+        if (k == 0) {
+            uint32_t qx = (uint32_t)std::lround(wx * unit * 65535.0);
+            uint32_t qy = (uint32_t)std::lround(wy * unit * 65535.0);
+            xy[idx] = qx << 16 | qy;
+            return;
+        }
+        const double w = (double)(1u << (k - 1));
+        for (int p = 0; p < 3; p++) {
+            int sub[3];
+            for (int q = 0; q < 3; q++) sub[q] = perm[q == p ? p : 3 - p - q];
+            build(k - 1, idx + (uint32_t)p * p3[k - 1], sub,
+                  wx + CX[perm[p]] * w, wy + CY[perm[p]] * w);
+        }
+    }
+};
+
+#endif // STATELAYOUT_H
@@ -0,0 +1,97 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for fork/join loops.
+// parallelFor splits [0,n) into one contiguous shard per thread; the calling
+// thread runs shard 0 itself and returns once every shard is finished.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0) : generation(0), pending(0), stopping(false), jobSize(0) {
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+        if (threads <= 0) threads = 1;
+        for (int i = 1; i < threads; i++)
+            workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t : workers) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    // fn(begin, end) is called once per non-empty shard; shard edges are
+    // multiples of `align` elements, which keeps shards large enough that
+    // neighbouring threads meet on at most the one cache line at each edge
+    // (storage is not line-aligned, so that line can still be shared)
+    void parallelFor(size_t n, const std::function<void(size_t, size_t)> &fn, size_t align = 64) {
+        if (n == 0) return;
+        if (workers.empty() || n <= align) { fn(0, n); return; }
+        {
+            std::lock_guard<std::mutex> lk(m);
+            job = fn;
+            jobSize = n;
+            jobAlign = align;
+            pending = (int)workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        runShard(0);
+        std::unique_lock<std::mutex> lk(m);
+        done.wait(lk, [this] { return pending == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable wake, done;
+    unsigned long generation;
+    int pending;
+    bool stopping;
+
+    std::function<void(size_t, size_t)> job;
+    size_t jobSize, jobAlign;
+
+    void runShard(int idx) {
+        size_t shards = (size_t)size();
+        size_t per = (jobSize + shards - 1) / shards;
+        per = (per + jobAlign - 1) / jobAlign * jobAlign;
+        size_t b = per * (size_t)idx;
+        size_t e = b + per < jobSize ? b + per : jobSize;
+        if (b < e) job(b, e);
+    }
+
+    void workerLoop(int idx) {
+        unsigned long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(m);
+                wake.wait(lk, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            runShard(idx);
+            {
+                std::lock_guard<std::mutex> lk(m);
+                if (--pending == 0) done.notify_one();
+            }
+        }
+    }
+};
+
+#endif // THREADPOOL_H
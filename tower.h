@@ -1,40 +1,97 @@
 #ifndef TOWER_H
 #define TOWER_H
 
-#include <stack>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "memstats.h"
 
+// One run of equal-size disks. Equal sizes on a peg are always adjacent (a
+// smaller disk between them would be under a larger one), so a peg holds at
+// most one run per size. `labels` keeps the order of the copies for the
+// order-preserving variant: 4 bits per disk, the top disk in the low bits.
+struct DiskRun {
+    int      size;
+    int      count;
+    uint64_t labels;
+};
+
+typedef std::vector<DiskRun, CountingAllocator<DiskRun>> RunStack;
+
+// A peg as a stack of runs, bottom first. The classic puzzle has runs of one;
+// with m copies of every size a full tower is n runs, not n*m ints.
 class Tower {
 public:
-    std::stack<int> disks;
+    static const int MAX_COPIES = 16;   // labels fit 16 disks per run
+
+    RunStack runs;
     std::string name;
 
-    Tower() : name("") {}
-    Tower(std::string n) : name(n) {}
+    Tower() : name(""), total(0) {}
+    Tower(std::string n)
+        : runs(CountingAllocator<DiskRun>(n == "A" ? MEM_TOWER_A : n == "B" ? MEM_TOWER_B
+                                         : n == "C" ? MEM_TOWER_C : MEM_UNTRACKED)),
+          name(n), total(0) {}
 
-    void push(int diskSize) {
-        disks.push(diskSize);
+    void push(int diskSize, int label = 0) {
+        if (!runs.empty() && runs.back().size == diskSize) {
+            DiskRun &r = runs.back();
+            r.count++;
+            r.labels = r.labels << 4 | (uint64_t)label;
+        } else {
+            runs.push_back(DiskRun{diskSize, 1, (uint64_t)label});
+        }
+        total++;
     }
 
     int pop() {
-        if (disks.empty()) return -1;
-        int t = disks.top();
-        disks.pop();
+        if (runs.empty()) return -1;
+        DiskRun &r = runs.back();
+        int t = r.size;
+        r.labels >>= 4;
+        if (--r.count == 0) runs.pop_back();
+        total--;
         return t;
     }
 
     int top() {
-        if (disks.empty()) return -1;
-        return disks.top();
+        if (runs.empty()) return -1;
+        return runs.back().size;
+    }
+
+    int topLabel() {
+        if (runs.empty()) return -1;
+        return (int)(runs.back().labels & 15);
     }
 
     bool isEmpty() {
-        return disks.empty();
+        return runs.empty();
     }
 
     int size() {
-        return (int)disks.size();
+        return total;
     }
+
+    void clear() {
+        runs.clear();
+        total = 0;
+    }
+
+    // bit k-1 set for every size on this peg
+    uint64_t mask() const {
+        uint64_t m = 0;
+        for (const DiskRun &r : runs) m |= 1ULL << (r.size - 1);
+        return m;
+    }
+
+    // one entry per disk, bottom first
+    void list(std::vector<int> &out) const {
+        out.clear();
+        for (const DiskRun &r : runs) out.insert(out.end(), r.count, r.size);
+    }
+
+private:
+    int total;   // disks over all runs
 };
 
 #endif // TOWER_H finish
@@ -0,0 +1,144 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Scoped trace zones for Chrome / Perfetto ("Trace Event Format" JSON).
+//
+//   TRACE_ZONE("MainWindow::redraw");
+//   TRACE_ZONE_IF(n == numDisks, "Game::generateSolution");
+//   ...
+//   traceWriteChrome("trace.json");   // open in ui.perfetto.dev or chrome://tracing
+//
+// Zones are only compiled in when HANOI_TRACE is defined (cmake -DHANOI_TRACE=ON).
+// Otherwise the macros expand to nothing and traceWriteChrome() returns false.
+//
+// Each thread appends to its own fixed-size buffer; the writer publishes the
+// event count with a release store, so recording never takes a lock. The
+// buffer is registered once per thread (under a mutex) and lives until exit,
+// so events from finished worker threads are still dumped.
+
+#ifdef HANOI_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TraceEvent {
+    const char *name;   // must be a string literal
+    int64_t startNs;
+    int64_t durNs;
+};
+
+class TraceBuffer {
+public:
+    static const int CAPACITY = 1 << 16;   // events per thread; later ones are dropped
+
+    explicit TraceBuffer(int tid) : tid(tid), count(0), dropped(0) {}
+
+    void record(const char *name, int64_t startNs, int64_t durNs) {
+        int n = count.load(std::memory_order_relaxed);
+        if (n >= CAPACITY) { dropped++; return; }
+        events[n] = TraceEvent{name, startNs, durNs};
+        count.store(n + 1, std::memory_order_release);
+    }
+
+    const int tid;
+    TraceEvent events[CAPACITY];
+    std::atomic<int> count;
+    int64_t dropped;
+};
+
+class TraceRegistry {
+public:
+    static TraceRegistry &instance() { static TraceRegistry r; return r; }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    TraceBuffer &local() {
+        thread_local TraceBuffer *buf = nullptr;
+        if (!buf) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.emplace_back(new TraceBuffer((int)buffers.size() + 1));
+            buf = buffers.back().get();
+        }
+        return *buf;
+    }
+
+    bool writeChrome(const char *path) {
+        FILE *f = fopen(path, "w");
+        if (!f) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t epochNs = INT64_MAX;   // earliest zone start becomes ts 0
+        for (auto &b : buffers)
+            for (int i = 0, n = b->count.load(std::memory_order_acquire); i < n; i++)
+                if (b->events[i].startNs < epochNs) epochNs = b->events[i].startNs;
+        fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool first = true;
+        for (auto &b : buffers) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"thread %d\"}}",
+                    first ? "" : ",\n", b->tid, b->tid);
+            first = false;
+            int n = b->count.load(std::memory_order_acquire);
+            for (int i = 0; i < n; i++) {
+                const TraceEvent &e = b->events[i];
+                fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                           "\"ts\":%.3f,\"dur\":%.3f}",
+                        e.name, b->tid, (e.startNs - epochNs) / 1000.0, e.durNs / 1000.0);
+            }
+            if (b->dropped)
+                fprintf(stderr, "trace: thread %d dropped %lld events\n", b->tid, (long long)b->dropped);
+        }
+        fprintf(f, "\n]}\n");
+        return fclose(f) == 0;
+    }
+
+private:
+    TraceRegistry() {}
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+class TraceZone {
+public:
+    explicit TraceZone(const char *name)
+        : name(name), start(name ? TraceRegistry::nowNs() : 0) {}
+    ~TraceZone() {
+        if (name) {
+            int64_t end = TraceRegistry::nowNs();
+            TraceRegistry::instance().local().record(name, start, end - start);
+        }
+    }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone &operator=(const TraceZone&) = delete;
+
+private:
+    const char *name;
+    int64_t start;
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone_, __LINE__)(name)
+#define TRACE_ZONE_IF(cond, name) TraceZone TRACE_CONCAT(traceZone_, __LINE__)((cond) ? (name) : nullptr)
+
+inline bool traceEnabled() { return true; }
+inline bool traceWriteChrome(const char *path) { return TraceRegistry::instance().writeChrome(path); }
+
+#else
+
+#define TRACE_ZONE(name) do {} while (0)
+#define TRACE_ZONE_IF(cond, name) do {} while (0)
+
+inline bool traceEnabled() { return false; }
+inline bool traceWriteChrome(const char *) { return false; }
+
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,174 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Restricted-move variants of the three-peg puzzle.
+//
+// A rule set is the directed graph of allowed single-disk moves between pegs
+// 0/1/2 (A/B/C), stored as a 9-bit mask with bit from*3+to:
+//   classic   every move
+//   cyclic    A->B, B->C, C->A only
+//   adjacent  A<->B and B<->C only (no direct A<->C)
+//   graph     any other mask, e.g. "AB,BC,CB,CA"
+//
+// Optimal solutions come from a table built once per (rules, n): moving a
+// tower of k disks from x to y either sends disk k straight across (when
+// x->y is allowed) or through the third peg z (x->z->y), whichever is
+// cheaper, with the k-1 smaller disks moved optimally around it. VariantStream
+// walks that table with an explicit stack, so moves are produced one at a
+// time in O(1) amortised work and O(n) memory; adjacentMove() gives the k-th
+// move of the adjacent variant directly.
+
+enum RulesKind { RULES_CLASSIC, RULES_CYCLIC, RULES_ADJACENT, RULES_GRAPH };
+
+struct MoveRules {
+    uint16_t mask;   // bit from*3+to
+
+    static MoveRules classic()  { return {0x1FF & ~0x111}; }   // everything but x->x
+    static MoveRules cyclic()   { return {1 << 1 | 1 << 5 | 1 << 6}; }          // AB BC CA
+    static MoveRules adjacent() { return {1 << 1 | 1 << 3 | 1 << 5 | 1 << 7}; } // AB BA BC CB
+
+    bool allows(int from, int to) const {
+        return from >= 0 && from < 3 && to >= 0 && to < 3 && (mask >> (from * 3 + to) & 1);
+    }
+    RulesKind kind() const {
+        if (mask == classic().mask)  return RULES_CLASSIC;
+        if (mask == cyclic().mask)   return RULES_CYCLIC;
+        if (mask == adjacent().mask) return RULES_ADJACENT;
+        return RULES_GRAPH;
+    }
+    const char *name() const {
+        static const char *names[] = {"classic", "cyclic", "adjacent", "graph"};
+        return names[kind()];
+    }
+    bool operator==(const MoveRules &o) const { return mask == o.mask; }
+    bool operator!=(const MoveRules &o) const { return mask != o.mask; }
+};
+
+// "classic", "cyclic", "adjacent" or a comma-separated edge list ("AB,BC,CA").
+inline bool parseMoveRules(const char *s, MoveRules &r) {
+    if (!strcmp(s, "classic"))  { r = MoveRules::classic();  return true; }
+    if (!strcmp(s, "cyclic"))   { r = MoveRules::cyclic();   return true; }
+    if (!strcmp(s, "adjacent") || !strcmp(s, "linear")) { r = MoveRules::adjacent(); return true; }
+    r.mask = 0;
+    for (const char *p = s; *p;) {
+        if (p[0] < 'A' || p[0] > 'C' || p[1] < 'A' || p[1] > 'C' || p[0] == p[1]) return false;
+        r.mask |= (uint16_t)(1 << ((p[0] - 'A') * 3 + (p[1] - 'A')));
+        p += 2;
+        if (*p == ',') p++;
+        else if (*p) return false;
+    }
+    return r.mask != 0;
+}
+
+// k-th move (1-based) of the optimal adjacent-variant solution taking n disks
+// from A to C (3^n - 1 moves). Disk d moves when 3^(d-1) is the largest power
+// of three dividing k, and every disk walks A B C B A B C ... in turn.
+inline void adjacentMove(uint64_t k, int &disk, int &from, int &to) {
+    static const int walk[4] = {0, 1, 2, 1};
+    uint64_t p = 1;
+    disk = 1;
+    while (k / p % 3 == 0) { p *= 3; disk++; }
+    uint64_t m = k / p - k / (p * 3);   // this is disk's m-th move
+    from = walk[(m - 1) % 4];
+    to   = walk[m % 4];
+}
+
+class VariantSolver {
+public:
+    static constexpr int MAX_DISKS = 40;            // 3^40 moves still fit in 64 bits
+    static constexpr uint64_t UNSOLVABLE = ~0ULL;
+
+    VariantSolver(MoveRules rules, int n) : rules(rules), n(n), table(n + 1) {
+        for (int x = 0; x < 3; x++)
+            for (int y = 0; y < 3; y++) { table[0].cost[x][y] = 0; table[0].via[x][y] = false; }
+        for (int k = 1; k <= n; k++) {
+            const Level &s = table[k - 1];
+            Level &l = table[k];
+            for (int x = 0; x < 3; x++)
+                for (int y = 0; y < 3; y++) {
+                    l.via[x][y] = false;
+                    l.cost[x][y] = 0;
+                    if (x == y) continue;
+                    int z = 3 - x - y;
+                    // disk k straight across: smaller disks wait on z
+                    uint64_t direct = rules.allows(x, y)
+                        ? add(add(s.cost[x][z], s.cost[z][y]), 1) : UNSOLVABLE;
+                    // disk k via z: smaller disks go to y, back to x, then to y
+                    uint64_t around = rules.allows(x, z) && rules.allows(z, y)
+                        ? add(add(add(s.cost[x][y], s.cost[y][x]), s.cost[x][y]), 2) : UNSOLVABLE;
+                    l.via[x][y] = around < direct;
+                    l.cost[x][y] = around < direct ? around : direct;
+                }
+        }
+    }
+
+    // optimal number of moves for the whole tower from peg `from` to `to`
+    uint64_t moveCount(int from = 0, int to = 2) const { return table[n].cost[from][to]; }
+    bool solvable(int from = 0, int to = 2) const { return moveCount(from, to) != UNSOLVABLE; }
+
+    const MoveRules rules;
+    const int n;
+
+private:
+    friend class VariantStream;
+    struct Level {
+        uint64_t cost[3][3];   // moves for a k-disk tower x -> y
+        bool     via[3][3];    // disk k goes x -> z -> y
+    };
+    std::vector<Level> table;
+
+    static uint64_t add(uint64_t a, uint64_t b) {
+        return a == UNSOLVABLE || b == UNSOLVABLE || a + b < a ? UNSOLVABLE : a + b;
+    }
+};
+
+// Streams the optimal solution move by move. The stack holds one frame per
+// tower still being moved; the last sub-tower of a frame replaces the frame
+// (a tail call), so depth never exceeds n.
+class VariantStream {
+public:
+    VariantStream(const VariantSolver &solver, int from = 0, int to = 2)
+        : s(solver), depth(0), count(0) {
+        if (s.n <= VariantSolver::MAX_DISKS && s.solvable(from, to)) push(s.n, from, to);
+    }
+
+    // false once the solution is complete
+    bool next(int &disk, int &from, int &to) {
+        while (depth > 0) {
+            Frame &f = stack[depth - 1];
+            int k = f.k, x = f.x, y = f.y, z = 3 - x - y;
+            int step = f.step++;
+            if (!s.table[k].via[x][y]) {
+                if (step == 0) push(k - 1, x, z);
+                else if (step == 1) { disk = k; from = x; to = y; count++; return true; }
+                else { depth--; push(k - 1, z, y); }
+            } else {
+                if (step == 0) push(k - 1, x, y);
+                else if (step == 1) { disk = k; from = x; to = z; count++; return true; }
+                else if (step == 2) push(k - 1, y, x);
+                else if (step == 3) { disk = k; from = z; to = y; count++; return true; }
+                else { depth--; push(k - 1, x, y); }
+            }
+        }
+        return false;
+    }
+
+    uint64_t emitted() const { return count; }
+
+private:
+    struct Frame { int8_t k, x, y, step; };
+    const VariantSolver &s;
+    Frame stack[VariantSolver::MAX_DISKS + 1];
+    int depth;
+    uint64_t count;
+
+    void push(int k, int x, int y) {
+        if (k > 0) stack[depth++] = Frame{(int8_t)k, (int8_t)x, (int8_t)y, 0};
+    }
+};
+
+#endif // VARIANT_H
@@ -0,0 +1,91 @@
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs fn(worker, begin, end) over [0,n) on `threads` workers.
+// Each worker owns a deque of index ranges; it splits its newest range in half
+// until it is no bigger than `grain` (lazy binary splitting), and when its deque
+// runs dry it steals the oldest (largest) range from another worker.
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(int threads) : nThreads(threads > 0 ? threads : 1) {}
+
+    int threads() const { return nThreads; }
+
+    void run(uint64_t n, uint64_t grain,
+             const std::function<void(int, uint64_t, uint64_t)> &fn) {
+        if (n == 0) return;
+        if (grain == 0) grain = 1;
+        std::vector<Queue> queues(nThreads);
+        // seed every worker with an equal slice so stealing is only needed for imbalance
+        for (int w = 0; w < nThreads; w++) {
+            uint64_t b = n * w / nThreads, e = n * (w + 1) / nThreads;
+            if (b < e) queues[w].d.push_back(Range{b, e});
+        }
+        std::atomic<uint64_t> remaining(n);
+
+        auto worker = [&](int w) {
+            Range r;
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                if (!popLocal(queues[w], r) && !steal(queues, w, r)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                while (r.end - r.begin > grain) {
+                    uint64_t mid = r.begin + (r.end - r.begin) / 2;
+                    pushLocal(queues[w], Range{mid, r.end});
+                    r.end = mid;
+                }
+                fn(w, r.begin, r.end);
+                remaining.fetch_sub(r.end - r.begin, std::memory_order_acq_rel);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int w = 1; w < nThreads; w++) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto &t : pool) t.join();
+    }
+
+private:
+    struct Range { uint64_t begin, end; };
+    struct alignas(64) Queue {
+        std::mutex m;
+        std::deque<Range> d;
+    };
+    int nThreads;
+
+    static void pushLocal(Queue &q, Range r) {
+        std::lock_guard<std::mutex> lk(q.m);
+        q.d.push_back(r);
+    }
+
+    static bool popLocal(Queue &q, Range &r) {
+        std::lock_guard<std::mutex> lk(q.m);
+        if (q.d.empty()) return false;
+        r = q.d.back();
+        q.d.pop_back();
+        return true;
+    }
+
+    bool steal(std::vector<Queue> &queues, int self, Range &r) {
+        for (int i = 1; i < nThreads; i++) {
+            Queue &q = queues[(self + i) % nThreads];
+            std::lock_guard<std::mutex> lk(q.m);
+            if (q.d.empty()) continue;
+            r = q.d.front();
+            q.d.pop_front();
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // WORKSTEALING_H
@@ -0,0 +1,134 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Zobrist keys — one random 64-bit word per (disk, peg).
+// A position hash is the XOR of the keys of every disk on its peg,
+// so moving one disk updates the hash with two XORs.
+class Zobrist {
+public:
+    static const int MAX_DISKS = 64;
+    static const int NUM_PEGS  = 3;
+
+    static uint64_t key(int disk, int peg) {
+        static const Table t;
+        return t.k[disk][peg];
+    }
+
+    // `count` equal disks of one size on a peg (the duplicate-size variant).
+    // Same as key() for a single disk and 0 for none, so classic hashes do
+    // not change; odd multipliers keep distinct counts apart where XORing
+    // equal keys would cancel.
+    static uint64_t key(int disk, int peg, int count) {
+        return count ? key(disk, peg) * (uint64_t)(2 * count - 1) : 0;
+    }
+
+    // An ordered run of copies (Tower's DiskRun: `count` disks, `labels` 4 bits
+    // each, top disk lowest). Reordering the same copies gives a different
+    // key; 0 for an empty run.
+    static uint64_t key(int disk, int peg, int count, uint64_t labels) {
+        if (!count) return 0;
+        uint64_t s = key(disk, peg) ^ (uint64_t)count;
+        s = splitmix64(s) ^ labels;
+        return splitmix64(s);
+    }
+
+private:
+    struct Table {
+        uint64_t k[MAX_DISKS + 1][NUM_PEGS];
+        Table() {
+            // fixed seed: hashes stay stable between runs (usable as cache keys)
+            uint64_t s = 0x9E3779B97F4A7C15ULL;
+            for (int d = 0; d <= MAX_DISKS; d++)
+                for (int p = 0; p < NUM_PEGS; p++)
+                    k[d][p] = splitmix64(s);
+        }
+    };
+
+    static uint64_t splitmix64(uint64_t &s) {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+// Open-addressing (linear probing) map: position hash -> first-seen move number.
+class RepeatIndex {
+public:
+    RepeatIndex() : count(0) { table.resize(64); }
+
+    void clear() {
+        table.assign(64, Slot());
+        count = 0;
+    }
+
+    // first-seen move number of this hash, or -1
+    int find(uint64_t h) const {
+        size_t mask = table.size() - 1;
+        for (size_t i = h & mask; table[i].move != -1; i = (i + 1) & mask)
+            if (table[i].hash == h) return table[i].move;
+        return -1;
+    }
+
+    // records h at move if unseen; returns the earlier move number if it was already seen, else -1
+    int insert(uint64_t h, int move) {
+        if ((count + 1) * 2 > table.size()) grow();
+        size_t mask = table.size() - 1;
+        size_t i = h & mask;
+        for (; table[i].move != -1; i = (i + 1) & mask)
+            if (table[i].hash == h) return table[i].move;
+        table[i].hash = h;
+        table[i].move = move;
+        count++;
+        return -1;
+    }
+
+    // backward-shift deletion, so no tombstones are left behind
+    void erase(uint64_t h) {
+        size_t mask = table.size() - 1;
+        size_t i = h & mask;
+        while (table[i].move != -1 && table[i].hash != h) i = (i + 1) & mask;
+        if (table[i].move == -1) return;
+
+        size_t j = i;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (table[j].move == -1) break;
+            size_t home = table[j].hash & mask;
+            // move j back into the hole at i unless its home lies cyclically in (i, j]
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (stays) continue;
+            table[i] = table[j];
+            i = j;
+        }
+        table[i] = Slot();
+        count--;
+    }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return table.capacity() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        int move;   // -1 = empty
+        Slot() : hash(0), move(-1) {}
+    };
+    std::vector<Slot> table;
+    size_t count;
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(table);
+        table.resize(old.size() * 2);
+        count = 0;
+        for (const Slot &s : old)
+            if (s.move != -1) insert(s.hash, s.move);
+    }
+};
+
+#endif // ZOBRIST_H